@@ -0,0 +1,208 @@
+// => hpc/analyzers/bounds/bounds.h
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#ifndef __human_plus_compiler_bounds
+#define __human_plus_compiler_bounds
+
+#include <hpc/ast/ast.h>
+#include <hpc/ast/visitor.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace hpc {
+    namespace bounds {
+
+        /*!
+         \brief The values taken by the induction variable of a \c for loop, as proven from its clauses.
+         \note The variable starts from \c lowerBound, is incremented by one at the end of each iteration and is never assigned in the loop, so it stays in <tt>[lowerBound, upperBound)</tt>, or <tt>[lowerBound, upperBound]</tt> if the range is inclusive.
+         */
+        struct InductionRange {
+            /*!
+             \brief The induction variable.
+             */
+            ast::Var *var = nullptr;
+            /*!
+             \brief The constant initial value of the variable, which is never negative.
+             */
+            int64_t lowerBound = 0;
+            /*!
+             \brief The expression the variable is compared to in the loop condition.
+             */
+            ast::Expr *upperBound = nullptr;
+            /*!
+             \brief Whether the loop condition uses \c <=, so that \c upperBound itself is reached.
+             */
+            bool inclusive = false;
+        };
+
+        /*!
+         \brief A bounds check done once before a loop, for all the accesses made in the loop with its induction variable.
+         */
+        struct HoistedCheck {
+            /*!
+             \brief The number of elements of the accessed array, or 0 if a slice is accessed.
+             */
+            uint64_t arrayLength;
+            /*!
+             \brief The variable holding the accessed slice, or \c nullptr if an array is accessed.
+             */
+            ast::Var *slice;
+        };
+
+        /*!
+         \brief Object which finds the accesses to arrays and slices that need no bounds check at run-time.
+         \note An access in a \c for loop whose index is the induction variable needs no check if the loop range is within the bounds.
+         Otherwise, if the access happens on every iteration of a loop without side effects, its check is hoisted before the loop, where the last index reached by the loop is checked once.
+         The analysis must run on a validated and simplified AST.
+         */
+        class BoundsCheckAnalysis : public ast::RecursiveVisitor<BoundsCheckAnalysis> {
+
+            /*!
+             \brief An access made with the induction variable of a loop being visited.
+             */
+            struct Candidate {
+                ast::SubscriptExpr *subscript;
+                /*!
+                 \brief Whether the access happens on every complete iteration of the loop.
+                 */
+                bool unconditional;
+            };
+
+            /*!
+             \brief Information about a loop being visited.
+             */
+            struct LoopInfo {
+                /*!
+                 \brief The loop, or \c nullptr if it is not a \c for loop with a known induction range.
+                 */
+                ast::ForStmt *loop = nullptr;
+                InductionRange range;
+                /*!
+                 \brief The variables assigned or declared anywhere in the loop, except for the increment of the induction variable.
+                 */
+                std::set<ast::Var *> variants;
+                /*!
+                 \brief Whether a \c break, \c continue or \c return statement may end an iteration early.
+                 */
+                bool exitsEarly = false;
+                /*!
+                 \brief Whether the loop calls a function or writes memory visible outside the function, which a check hoisted before the loop would skip when it traps.
+                 */
+                bool hasSideEffects = false;
+                /*!
+                 \brief The value of \c conditionalDepth in the loop body.
+                 */
+                unsigned depth = 0;
+                std::vector<Candidate> candidates;
+            };
+
+            /*!
+             \brief The induction ranges of the \c for loops with hoisted checks.
+             */
+            std::map<ast::ForStmt *, InductionRange> ranges;
+            /*!
+             \brief The checks to be done before each \c for loop.
+             */
+            std::map<ast::ForStmt *, std::vector<HoistedCheck>> hoistedChecks;
+            /*!
+             \brief The accesses proven to be in bounds, or whose check has been hoisted.
+             */
+            std::set<ast::SubscriptExpr *> uncheckedAccesses;
+
+            /*!
+             \brief The loops containing the statement being visited, from the outermost to the innermost.
+             */
+            std::vector<LoopInfo> loops;
+            /*!
+             \brief The number of conditional statements and loop bodies containing the statement being visited.
+             */
+            unsigned conditionalDepth = 0;
+
+            /*!
+             \brief Returns whether the given \c for loop has an induction variable, and stores its range in \c range.
+             \param increment Receives the end statement incrementing the induction variable.
+             */
+            static bool getInductionRange(ast::ForStmt *statement, InductionRange &range, ast::Stmt *&increment);
+            /*!
+             \brief Marks the given variable as changing in all the loops being visited.
+             */
+            void markVariant(ast::Var *var);
+            /*!
+             \brief Returns whether \c expression evaluates to the same value in every iteration of the given loop.
+             */
+            bool isLoopInvariant(ast::Expr *expression, const LoopInfo &loop) const;
+            /*!
+             \brief Decides which accesses made with the induction variable of the given loop need no check.
+             */
+            void resolveCandidates(const LoopInfo &loop);
+            /*!
+             \brief Visits the condition, the end statements and the block of the given loop.
+             */
+            void visitLoop(ast::SimpleIterStmt *statement, ast::ForStmt *forStmt);
+
+            inline void scan(ast::Stmt *stmt) {
+                if (stmt) takeStmt(stmt);
+            }
+
+        public:
+            /*!
+             \brief Finds the accesses needing no bounds check in all the functions of the given AST.
+             */
+            void analyze(ast::AbstractSyntaxTree *ast);
+
+            /*!
+             \brief Returns whether the given access to an array or a slice must be checked where it happens.
+             */
+            inline bool needsCheck(ast::SubscriptExpr *subscript) const { return !uncheckedAccesses.count(subscript); }
+
+            /*!
+             \brief Returns the checks to be done before the given loop.
+             */
+            const std::vector<HoistedCheck> &getHoistedChecks(ast::ForStmt *statement) const;
+            /*!
+             \brief Returns the range of the induction variable of the given loop, or \c nullptr if the loop has no hoisted checks.
+             */
+            const InductionRange *getInductionRange(ast::ForStmt *statement) const;
+
+
+            void visitNameSpaceDecl(ast::NameSpaceDecl *nameSpace);
+            void visitFunctionDecl(ast::FunctionDecl *function);
+
+            void visitCompoundStmt(ast::CompoundStmt *statement);
+            void visitVarDeclStmt(ast::VarDeclStmt *statement);
+            void visitReturnStmt(ast::ReturnStmt *statement);
+            void visitBreakStmt(ast::BreakStmt *statement);
+            void visitContinueStmt(ast::ContinueStmt *statement);
+
+            void visitIfStmt(ast::IfStmt *statement);
+            void visitSwitchStmt(ast::SwitchStmt *statement);
+            void visitCaseStmt(ast::CaseStmt *statement) {  }
+            void visitSimpleIterStmt(ast::SimpleIterStmt *statement);
+            void visitForStmt(ast::ForStmt *statement);
+
+            void visitImplicitCastExpr(ast::ImplicitCastExpr *cast);
+            void visitEvalExpr(ast::EvalExpr *cast);
+            void visitBinaryExpr(ast::BinaryExpr *expression);
+            void visitAssignmentExpr(ast::AssignmentExpr *expression);
+            void visitUnaryExpr(ast::UnaryExpr *expression);
+
+            void visitFunctionCall(ast::FunctionCall *functionCall);
+            void visitFieldRef(ast::FieldRef *fieldRef);
+            void visitSubscriptExpr(ast::SubscriptExpr *subscript);
+            void visitLengthExpr(ast::LengthExpr *length);
+            void visitShuffleExpr(ast::ShuffleExpr *shuffle);
+
+        };
+
+    }
+}
+
+#endif
@@ -168,10 +168,6 @@ namespace hpc {
              \brief Token describing the \c or keyword.
              */
             TokenOperatorLogicalOr               = -32,
-            /*!
-             \brief Token describing the \c switch keyword.
-             */
-            TokenSwitch                          = -32,
             /*!
              \brief Token describing the \c break keyword.
              */
@@ -180,6 +176,70 @@ namespace hpc {
              \brief Token describing the \c continue keyword.
              */
             TokenContinue                        = -34,
+            /*!
+             \brief Token describing the \c pinned keyword.
+             */
+            TokenPinned                          = -35,
+            /*!
+             \brief Token describing the \c aligned keyword.
+             */
+            TokenAligned                         = -36,
+            /*!
+             \brief Token describing the \c packed keyword.
+             */
+            TokenPacked                          = -37,
+            /*!
+             \brief Token describing the \c padded keyword.
+             */
+            TokenPadded                          = -38,
+            /*!
+             \brief Token describing the \c vector keyword.
+             */
+            TokenVector                          = -39,
+            /*!
+             \brief Token describing the \c shuffle keyword.
+             */
+            TokenShuffle                         = -40,
+            /*!
+             \brief Token describing the \c array keyword.
+             */
+            TokenArray                           = -41,
+            /*!
+             \brief Token describing the \c slice keyword.
+             */
+            TokenSlice                           = -42,
+            /*!
+             \brief Token describing the \c exclusive keyword.
+             */
+            TokenExclusive                       = -43,
+            /*!
+             \brief Token describing the \c switch keyword.
+             */
+            TokenSwitch                          = -44,
+            /*!
+             \brief Token describing the \c case keyword.
+             */
+            TokenCase                            = -45,
+            /*!
+             \brief Token describing the \c default keyword.
+             */
+            TokenDefault                         = -46,
+            /*!
+             \brief Token describing the \c likely keyword.
+             */
+            TokenLikely                          = -47,
+            /*!
+             \brief Token describing the \c unlikely keyword.
+             */
+            TokenUnlikely                        = -48,
+            /*!
+             \brief Token describing the \c rarely keyword.
+             */
+            TokenRarely                          = -49,
+            /*!
+             \brief Token describing the \c loop keyword.
+             */
+            TokenLoop                            = -58,
             
             /*!
              \brief Token describing a number literal that fits into an integer.
@@ -536,6 +596,10 @@ namespace hpc {
              \brief Ignores the current token if this is an 'and'.
              */
             void ignoreAndIfAny();
+            /*!
+             \brief Ignores the current token if this is a 'to'.
+             */
+            void ignoreToIfAny();
             
 
             /*!
@@ -238,6 +238,10 @@ namespace hpc {
              \note <b>Always</b> control whether this method returned \c false, or if \c EOF is still unexpected after this entity, just control if \c lexer::eof(). As to avoid the control to be stuck on an infinite iteration, the parser control <b>must</b> immediately return to \c lexer::parseTopLevel(), and return \c false.
              */
             bool parseComplement(ast::Stmt *&statement);
+            /*!
+             \brief Parses the \c likely or \c unlikely hint following the \c if token, if any, and returns it.
+             */
+            ast::IfStmt::BranchHint parseBranchHint();
             /*!
              \brief Parses the next statement in the lexer's stream, starting from the opening token '{' as current token at the moment of the call, and puts the pointer into \c parsing.
              \param parsing A reference to the pointer to an \c ast::CompoundStmt object. The pointer will be set to the pointer to an object describing the parsed statement.
@@ -278,6 +282,14 @@ namespace hpc {
              \note <b>Always</b> control whether this method returned \c false, or if \c EOF is still unexpected after this entity, just control if \c lexer::eof(). As to avoid the control to be stuck on an infinite iteration, the parser control <b>must</b> immediately return to \c lexer::parseTopLevel(), and return \c false.
              */
             bool parseSwitchStatement(ast::Stmt *&parsing, ast::FunctionDecl *containerFunc);
+            /*!
+             \brief Parses the next \c case or \c default label in the lexer's stream, starting from the \c case or \c default token as current token at the moment of the call, and puts the pointer into \c parsing.
+             \param parsing A reference to the pointer to an \c ast::Stmt object. The pointer will be set to the pointer to an object describing the parsed label.
+             \param containerFunc A pointer to a \c ast::FunctionDecl describing the function to which the parsed label should be added. The function <b>will not</b> add the label to the function.
+             \return \c false if an \c EOF is found during the parsing process, \c true otherwise.
+             \note <b>Always</b> control whether this method returned \c false, or if \c EOF is still unexpected after this entity, just control if \c lexer::eof(). As to avoid the control to be stuck on an infinite iteration, the parser control <b>must</b> immediately return to \c lexer::parseTopLevel(), and return \c false.
+             */
+            bool parseCaseLabel(ast::Stmt *&parsing, ast::FunctionDecl *containerFunc);
             /*!
              \brief Parses the next \c while or \c until iteration statement in the lexer's stream, starting from the \c do token as current token at the moment of the call, and puts the pointer into \c parsing.
              \param parsing A reference to the pointer to an \c ast::Stmt object. The pointer will be set to the pointer to an object describing the parsed statement.
@@ -302,6 +314,14 @@ namespace hpc {
              \note <b>Always</b> control whether this method returned \c false, or if \c EOF is still unexpected after this entity, just control if \c lexer::eof(). As to avoid the control to be stuck on an infinite iteration, the parser control <b>must</b> immediately return to \c lexer::parseTopLevel(), and return \c false.
              */
             bool parseForIterationStatement(ast::Stmt *&parsing, ast::FunctionDecl *containerFunc);
+            /*!
+             \brief Parses the optimization directives of the next iteration statement in the lexer's stream, starting from the \c loop token as current token at the moment of the call, then parses the iteration statement and puts the pointer into \c parsing.
+             \param parsing A reference to the pointer to an \c ast::Stmt object. The pointer will be set to the pointer to an object describing the parsed iteration statement.
+             \param containerFunc A pointer to a \c ast::FunctionDecl describing the function to which the parsed statement should be added. The function <b>will not</b> add the statement to the function.
+             \return \c false if an \c EOF is found during the parsing process, \c true otherwise.
+             \note <b>Always</b> control whether this method returned \c false, or if \c EOF is still unexpected after this entity, just control if \c lexer::eof(). As to avoid the control to be stuck on an infinite iteration, the parser control <b>must</b> immediately return to \c lexer::parseTopLevel(), and return \c false.
+             */
+            bool parseLoopDirectives(ast::Stmt *&parsing, ast::FunctionDecl *containerFunc);
             /*!
              \brief Parses the next \c return statement in the lexer's stream, starting from the \c return token as current token at the moment of the call, and puts the pointer into \c parsing.
              \param parsing A reference to the pointer to an \c ast::Stmt object. The pointer will be set to the pointer to an object describing the parsed statement.
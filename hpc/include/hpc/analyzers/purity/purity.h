@@ -0,0 +1,181 @@
+// => hpc/analyzers/purity/purity.h
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#ifndef __human_plus_compiler_purity
+#define __human_plus_compiler_purity
+
+#include <hpc/ast/ast.h>
+#include <hpc/ast/visitor.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace hpc {
+    namespace purity {
+
+        /*!
+         \brief The side effects inferred for a single function.
+         */
+        struct FunctionSummary {
+            /*!
+             \brief Whether the function, or any function it calls, may read global memory.
+             */
+            bool readsMemory = false;
+            /*!
+             \brief Whether the function, or any function it calls, may write global memory.
+             */
+            bool writesMemory = false;
+            /*!
+             \brief Whether the function writes one of its class or array arguments, which may be passed in memory.
+             */
+            bool writesObjectArgs = false;
+            /*!
+             \brief Whether the function may loop forever or call a function that may not return.
+             */
+            bool mayNotReturn = false;
+            /*!
+             \brief Whether the function may call itself, directly or indirectly.
+             */
+            bool mayRecurse = false;
+            /*!
+             \brief For each argument, whether a pointer received in it may outlive the call (being stored, returned or passed to a function that captures it).
+             */
+            std::vector<bool> capturedArgs;
+            /*!
+             \brief The functions called by this function.
+             */
+            std::set<ast::FunctionDecl *> callees;
+        };
+
+        /*!
+         \brief Object which infers the side effects of every function with a body in a validated AST.
+         \note Functions without a body are defined outside the program, so they are assumed to read and write any memory, to capture their arguments and to possibly call back any function.
+         */
+        class PurityAnalysis : public ast::RecursiveVisitor<PurityAnalysis> {
+
+            /*!
+             \brief Information about a pointer argument passed to a function by the function being summarized.
+             */
+            struct ArgumentFlow {
+                ast::FunctionDecl *caller;
+                unsigned callerArg;
+                ast::FunctionDecl *callee;
+                unsigned calleeArg;
+            };
+
+            /*!
+             \brief The summaries for all the functions with a body.
+             */
+            std::map<ast::FunctionDecl *, FunctionSummary> summaries;
+            /*!
+             \brief The arguments of a function passed straight to another function, whose capture depends on the callee.
+             */
+            std::vector<ArgumentFlow> argumentFlows;
+
+            /*!
+             \brief The function being summarized.
+             */
+            ast::FunctionDecl *current = nullptr;
+            /*!
+             \brief The summary of the function being summarized.
+             */
+            FunctionSummary *currentSummary = nullptr;
+
+            /*!
+             \brief Collects and summarizes the local effects of all the functions in the given namespace.
+             */
+            void collectFunctions(ast::NameSpaceDecl *nameSpace);
+            /*!
+             \brief Returns the index of \c var in the arguments of the function being summarized, or \c -1 if it is not a pointer argument.
+             */
+            int getPointerArgIndex(ast::Var *var) const;
+            /*!
+             \brief Propagates the effects of the callees to their callers, until nothing changes.
+             */
+            void propagate();
+            /*!
+             \brief Returns whether \c target can be called, directly or indirectly, by \c function.
+             */
+            bool canCall(ast::FunctionDecl *function, ast::FunctionDecl *target) const;
+
+            inline void scan(ast::Stmt *stmt) {
+                if (stmt) takeStmt(stmt);
+            }
+
+        public:
+            /*!
+             \brief Infers the side effects of all the functions in the given AST.
+             */
+            void analyze(ast::AbstractSyntaxTree *ast);
+
+            /*!
+             \brief Returns the summary for the given function, or \c nullptr if the function has no body.
+             */
+            const FunctionSummary *getSummary(ast::FunctionDecl *function) const;
+
+            /*!
+             \brief Returns whether the given function does not access memory visible to its caller.
+             */
+            bool isReadNone(ast::FunctionDecl *function) const;
+            /*!
+             \brief Returns whether the given function may read but never writes memory visible to its caller.
+             */
+            bool isReadOnly(ast::FunctionDecl *function) const;
+            /*!
+             \brief Returns whether the given function may write the class or array objects it receives as arguments.
+             \note The objects passed in memory are written in place, which is not allowed for functions that only read memory.
+             */
+            bool writesObjectArgs(ast::FunctionDecl *function) const;
+            /*!
+             \brief Returns whether the given function never calls itself, directly or indirectly.
+             */
+            bool isNoRecurse(ast::FunctionDecl *function) const;
+            /*!
+             \brief Returns whether every call to the given function returns to its caller.
+             */
+            bool alwaysReturns(ast::FunctionDecl *function) const;
+            /*!
+             \brief Returns whether the pointer passed to the given function as argument number \c argNo is not kept after the call.
+             */
+            bool isNoCapture(ast::FunctionDecl *function, unsigned argNo) const;
+
+
+            void visitFunctionDecl(ast::FunctionDecl *function);
+
+            void visitCompoundStmt(ast::CompoundStmt *statement);
+            void visitVarDeclStmt(ast::VarDeclStmt *statement);
+            void visitReturnStmt(ast::ReturnStmt *statement);
+
+            void visitIfStmt(ast::IfStmt *statement);
+            void visitSwitchStmt(ast::SwitchStmt *statement);
+            void visitCaseStmt(ast::CaseStmt *statement);
+            void visitSimpleIterStmt(ast::SimpleIterStmt *statement);
+            void visitForStmt(ast::ForStmt *statement);
+
+            void visitImplicitCastExpr(ast::ImplicitCastExpr *cast);
+            void visitEvalExpr(ast::EvalExpr *cast);
+            void visitBinaryExpr(ast::BinaryExpr *expression);
+            void visitComparisonExpr(ast::ComparisonExpr *expression);
+            void visitAssignmentExpr(ast::AssignmentExpr *expression);
+            void visitUnaryExpr(ast::UnaryExpr *expression);
+
+            void visitVarRef(ast::VarRef *varRef);
+            void visitFunctionCall(ast::FunctionCall *functionCall);
+            void visitFieldRef(ast::FieldRef *fieldRef);
+            void visitSubscriptExpr(ast::SubscriptExpr *subscript);
+            void visitLengthExpr(ast::LengthExpr *length);
+            void visitShuffleExpr(ast::ShuffleExpr *shuffle);
+
+        };
+
+    }
+}
+
+#endif
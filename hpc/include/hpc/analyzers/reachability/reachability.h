@@ -0,0 +1,106 @@
+// => hpc/analyzers/reachability/reachability.h
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#ifndef __human_plus_compiler_reachability
+#define __human_plus_compiler_reachability
+
+#include <hpc/ast/ast.h>
+#include <hpc/ast/visitor.h>
+
+#include <set>
+#include <vector>
+
+namespace hpc {
+    namespace reachability {
+
+        /*!
+         \brief Object which computes the declarations reachable from the roots of a whole program.
+         \note The roots are the \c main function and every \c nostalgic function with a body, since these can be called from outside the program, and every global variable initialized at program startup, since its initial value may have side effects. The analysis must run on a validated AST, as it follows the references resolved by the validator.
+         */
+        class ReachabilityAnalysis : public ast::RecursiveVisitor<ReachabilityAnalysis> {
+
+            /*!
+             \brief The declarations found to be reachable so far.
+             */
+            std::set<ast::Decl *> reachable;
+            /*!
+             \brief The reachable declarations whose references have not been followed yet.
+             */
+            std::vector<ast::Decl *> worklist;
+
+            /*!
+             \brief Marks the given declaration as reachable, scheduling it to be scanned if it was not reachable before.
+             */
+            void markReachable(ast::Decl *decl);
+            /*!
+             \brief Marks as reachable the declarations the given type depends on.
+             */
+            void markType(ast::Type *type);
+            /*!
+             \brief Adds the roots contained in the given namespace to the worklist.
+             */
+            void collectRoots(ast::NameSpaceDecl *nameSpace);
+
+            inline void scan(ast::Stmt *stmt) {
+                if (stmt) takeStmt(stmt);
+            }
+
+        public:
+            /*!
+             \brief Computes the set of reachable declarations in the given AST.
+             */
+            void analyze(ast::AbstractSyntaxTree *ast);
+
+            /*!
+             \brief Returns whether \c decl is reachable from any of the roots of the program.
+             */
+            inline bool isReachable(ast::Decl *decl) const { return reachable.count(decl); }
+
+            /*!
+             \brief Returns whether \c function is a root for the analysis.
+             */
+            static bool isRoot(ast::FunctionDecl *function);
+            /*!
+             \brief Returns whether \c var is a root for the analysis.
+             */
+            static bool isRoot(ast::GlobalVar *var);
+
+
+            void visitGlobalVar(ast::GlobalVar *var);
+            void visitFunctionDecl(ast::FunctionDecl *function);
+            void visitClassDecl(ast::ClassDecl *classDecl);
+
+            void visitCompoundStmt(ast::CompoundStmt *statement);
+            void visitVarDeclStmt(ast::VarDeclStmt *statement);
+            void visitReturnStmt(ast::ReturnStmt *statement);
+
+            void visitIfStmt(ast::IfStmt *statement);
+            void visitSwitchStmt(ast::SwitchStmt *statement);
+            void visitCaseStmt(ast::CaseStmt *statement);
+            void visitSimpleIterStmt(ast::SimpleIterStmt *statement);
+            void visitForStmt(ast::ForStmt *statement);
+
+            void visitImplicitCastExpr(ast::ImplicitCastExpr *cast);
+            void visitEvalExpr(ast::EvalExpr *cast);
+            void visitBinaryExpr(ast::BinaryExpr *expression);
+            void visitUnaryExpr(ast::UnaryExpr *expression);
+
+            void visitVarRef(ast::VarRef *varRef);
+            void visitFunctionCall(ast::FunctionCall *functionCall);
+            void visitFieldRef(ast::FieldRef *fieldRef);
+            void visitSubscriptExpr(ast::SubscriptExpr *subscript);
+            void visitLengthExpr(ast::LengthExpr *length);
+            void visitShuffleExpr(ast::ShuffleExpr *shuffle);
+
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,85 @@
+// => hpc/analyzers/simplifier/simplifier.h
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#ifndef __human_plus_compiler_simplifier
+#define __human_plus_compiler_simplifier
+
+#include <hpc/ast/ast.h>
+#include <hpc/ast/visitor.h>
+
+namespace hpc {
+    namespace simplifier {
+
+        /*!
+         \brief Object which simplifies a validated AST before code generation.
+         \note It folds arithmetic, bitwise and comparison expressions between literals, drops the implicit casts between equivalent types and merges the chains of implicit casts that can be done at once.
+         */
+        class ASTSimplifier : public ast::RecursiveVisitor<ASTSimplifier> {
+
+            /*!
+             \brief The expression that replaces the last expression visited.
+             */
+            ast::Expr *simplified = nullptr;
+
+            /*!
+             \brief Simplifies the given expression and returns the expression that should replace it.
+             */
+            ast::Expr *simplify(ast::Expr *expression);
+
+            inline void scan(ast::Stmt *stmt) {
+                if (stmt) takeStmt(stmt);
+            }
+
+        public:
+            /*!
+             \brief Simplifies all the declarations in the given AST.
+             \warning The AST must have been validated without errors.
+             */
+            void simplifyAST(ast::AbstractSyntaxTree *ast);
+
+
+            void visitNameSpaceDecl(ast::NameSpaceDecl *nameSpace);
+            void visitGlobalVar(ast::GlobalVar *var);
+            void visitFunctionDecl(ast::FunctionDecl *function);
+            void visitClassDecl(ast::ClassDecl *classDecl);
+
+            void visitCompoundStmt(ast::CompoundStmt *statement);
+            void visitVarDeclStmt(ast::VarDeclStmt *statement);
+            void visitReturnStmt(ast::ReturnStmt *statement);
+
+            void visitIfStmt(ast::IfStmt *statement);
+            void visitSwitchStmt(ast::SwitchStmt *statement);
+            void visitCaseStmt(ast::CaseStmt *statement);
+            void visitSimpleIterStmt(ast::SimpleIterStmt *statement);
+            void visitForStmt(ast::ForStmt *statement);
+
+            void visitExpr(ast::Expr *expression);
+
+            void visitImplicitCastExpr(ast::ImplicitCastExpr *cast);
+            void visitEvalExpr(ast::EvalExpr *cast);
+
+            void visitBinaryExpr(ast::BinaryExpr *expression);
+            void visitAssignmentExpr(ast::AssignmentExpr *expression);
+
+            void visitArithmeticNegationExpr(ast::ArithmeticNegationExpr *expression);
+            void visitLogicalNegationExpr(ast::LogicalNegationExpr *expression);
+            void visitBitwiseNegationExpr(ast::BitwiseNegationExpr *expression);
+
+            void visitFunctionCall(ast::FunctionCall *functionCall);
+            void visitFieldRef(ast::FieldRef *fieldRef);
+            void visitSubscriptExpr(ast::SubscriptExpr *subscript);
+            void visitLengthExpr(ast::LengthExpr *length);
+            void visitShuffleExpr(ast::ShuffleExpr *shuffle);
+
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,119 @@
+// => hpc/analyzers/validator/performance.h
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#ifndef __human_plus_compiler_validator_performance
+#define __human_plus_compiler_validator_performance
+
+#include <hpc/ast/ast.h>
+#include <hpc/ast/visitor.h>
+#include <hpc/analyzers/purity/purity.h>
+#include <hpc/diagnostics/diagnostics.h>
+
+#include <set>
+#include <vector>
+
+namespace hpc {
+    namespace validator {
+
+        /*!
+         \brief Object which reports warnings about code patterns known to generate slow code (-Wperformance).
+         \note It must run on a validated AST, after the simplifier, so that casts and operations between literals are not reported, and after the purity analysis.
+         */
+        class PerformanceLint : public ast::RecursiveVisitor<PerformanceLint> {
+
+            /*!
+             \brief Information about a loop being visited.
+             */
+            struct LoopInfo {
+                /*!
+                 \brief The variables assigned or declared anywhere in the loop.
+                 */
+                std::set<ast::Var *> variants;
+                /*!
+                 \brief The function calls found in the loop condition.
+                 */
+                std::vector<ast::FunctionCall *> conditionCalls;
+            };
+
+            /*!
+             \brief The diagnostics engine the warnings are reported to.
+             */
+            diag::DiagEngine &diags;
+            /*!
+             \brief The side effects of the functions, so that only the calls which can be hoisted are reported.
+             */
+            const purity::PurityAnalysis &purity;
+            /*!
+             \brief The loops containing the statement being visited, from the outermost to the innermost.
+             */
+            std::vector<LoopInfo> loops;
+            /*!
+             \brief A boolean indicating whether the expression being visited is part of the condition of the innermost loop.
+             */
+            bool inLoopCondition = false;
+
+            /*!
+             \brief Marks the given variable as changing in all the loops being visited.
+             */
+            void markVariant(ast::Var *var);
+            /*!
+             \brief Returns whether \c expression evaluates to the same value in every iteration of the given loop.
+             */
+            bool isLoopInvariant(ast::Expr *expression, const LoopInfo &loop);
+            /*!
+             \brief Visits the condition and the block of the given loop, then reports the invariant calls found in its condition.
+             */
+            void lintLoop(ast::SimpleIterStmt *statement, const std::vector<ast::Stmt *> &endStatements);
+
+            inline void scan(ast::Stmt *stmt) {
+                if (stmt) takeStmt(stmt);
+            }
+
+        public:
+            PerformanceLint(diag::DiagEngine &diags, const purity::PurityAnalysis &purity) : diags(diags), purity(purity) {  }
+
+            /*!
+             \brief Reports the performance warnings for all the declarations in the given AST.
+             */
+            void lintAST(ast::AbstractSyntaxTree *ast);
+
+
+            void visitNameSpaceDecl(ast::NameSpaceDecl *nameSpace);
+            void visitGlobalVar(ast::GlobalVar *var);
+            void visitFunctionDecl(ast::FunctionDecl *function);
+            void visitClassDecl(ast::ClassDecl *classDecl) {  }
+
+            void visitCompoundStmt(ast::CompoundStmt *statement);
+            void visitVarDeclStmt(ast::VarDeclStmt *statement);
+            void visitReturnStmt(ast::ReturnStmt *statement);
+
+            void visitIfStmt(ast::IfStmt *statement);
+            void visitSwitchStmt(ast::SwitchStmt *statement);
+            void visitCaseStmt(ast::CaseStmt *statement) {  }
+            void visitSimpleIterStmt(ast::SimpleIterStmt *statement);
+            void visitForStmt(ast::ForStmt *statement);
+
+            void visitImplicitCastExpr(ast::ImplicitCastExpr *cast);
+            void visitEvalExpr(ast::EvalExpr *cast);
+            void visitBinaryExpr(ast::BinaryExpr *expression);
+            void visitAssignmentExpr(ast::AssignmentExpr *expression);
+            void visitUnaryExpr(ast::UnaryExpr *expression);
+
+            void visitFunctionCall(ast::FunctionCall *functionCall);
+            void visitFieldRef(ast::FieldRef *fieldRef);
+            void visitSubscriptExpr(ast::SubscriptExpr *subscript);
+            void visitLengthExpr(ast::LengthExpr *length);
+            void visitShuffleExpr(ast::ShuffleExpr *shuffle);
+
+        };
+
+    }
+}
+
+#endif
@@ -78,6 +78,13 @@ namespace hpc {
                 return localStacks.back();
             }
             
+            /*!
+             \brief Returns whether a function is being validated, so that a local stack is opened.
+             */
+            inline bool hasLocalStack() const {
+                return !localStacks.empty();
+            }
+            
             /*!
              \brief Switches the current namespace to the given namespace.
              */
@@ -212,6 +219,13 @@ namespace hpc {
              */
             LocalStack(SymbolResolver &resolver, ast::FunctionDecl *F);
             
+            /*!
+             \brief Returns the function this stack is tracking.
+             */
+            inline ast::FunctionDecl *getFunction() const {
+                return F;
+            }
+            
             /*!
              \brief Returns an array of the scopes contained in the LocalStack at the moment of the call to this method.
              */
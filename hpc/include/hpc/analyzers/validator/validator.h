@@ -14,12 +14,17 @@
 #include <hpc/ast/visitor.h>
 #include <hpc/analyzers/validator/resolver.h>
 #include <hpc/diagnostics/diagnostics.h>
+#include <hpc/target/target.h>
 
 #include <string>
 #include <vector>
 #include <map>
 
 namespace hpc {
+    namespace codegen {
+        class ModuleBuilder;
+    }
+    
     namespace validator {
         
         /*!
@@ -30,9 +35,21 @@ namespace hpc {
              \brief The diagnostics engine this compilation has to report diagnostics to.
              */
             diag::DiagEngine &diags;
+            /*!
+             \brief The target the program is compiled for, or \c nullptr if checks depending on the target data layout should be skipped.
+             */
+            target::TargetInfo *targetInfo = nullptr;
+            /*!
+             \brief The module holding the IR types built by \c layoutBuilder.
+             */
+            modules::ModuleWrapper *layoutModule = nullptr;
+            /*!
+             \brief The module builder giving the alignment of the types on the target, or \c nullptr if it has not been needed yet.
+             */
+            codegen::ModuleBuilder *layoutBuilder = nullptr;
         
         public:
-            virtual ~ValidatorInstance() {  }
+            virtual ~ValidatorInstance();
             
             ValidatorInstance(diag::DiagEngine &diags);
             
@@ -40,6 +57,23 @@ namespace hpc {
                 return diags;
             }
             
+            /*!
+             \brief Sets the target whose data layout the class attributes are checked against.
+             \note The target machine of \c targetInfo must have been created.
+             */
+            inline void setTargetInfo(target::TargetInfo *target) {
+                targetInfo = target;
+            }
+            
+            inline target::TargetInfo *getTargetInfo() const {
+                return targetInfo;
+            }
+            /*!
+             \brief Returns a module builder for the target, which gives the alignment of the types as the code generator lays them out.
+             \note A target must have been set.
+             */
+            codegen::ModuleBuilder &getLayoutBuilder();
+            
             /*!
              \brief Starts a validation session on the given AST.
              */
@@ -65,6 +99,19 @@ namespace hpc {
              \brief The SymbolPrevResolver object that will be used to resolve references.
              */
             SymbolResolver *resolver;
+            /*!
+             \brief The return statements of the function being validated whose value has been requested to be a tail call.
+             */
+            std::vector<ast::ReturnStmt *> tailCalls;
+            
+            /*!
+             \brief Reports the invalid alignment and padding attributes of the given class.
+             */
+            void checkClassAttributes(ast::ClassDecl *classDecl);
+            /*!
+             \brief Marks the function being validated as making slices of its stack if \c value is a local array converted to the slice type \c destination.
+             */
+            void checkStackSlice(ast::Expr *value, ast::Type *destination);
             
         public:
             ValidatorImpl(ValidatorInstance &validator, ast::AbstractSyntaxTree *ast);
@@ -98,7 +145,11 @@ namespace hpc {
             
             void visitTypeRef(ast::TypeRef *typeRef);
             
+            void visitQualifiedType(ast::QualifiedType *type);
             void visitPointerType(ast::PointerType *type);
+            void visitVectorType(ast::VectorType *type);
+            void visitArrayType(ast::ArrayType *type);
+            void visitSliceType(ast::SliceType *type);
             void visitClassType(ast::ClassType *type);
             
             void visitNameSpaceDecl(ast::NameSpaceDecl *nameSpace);
@@ -122,7 +173,8 @@ namespace hpc {
             void visitContinueStmt(ast::ContinueStmt *statement);
             
             void visitIfStmt(ast::IfStmt *statement);
-            //void visitSwitchStmt(ast::SwitchStmt *statement) {  }
+            void visitSwitchStmt(ast::SwitchStmt *statement);
+            void visitCaseStmt(ast::CaseStmt *statement);
             
             void visitSimpleIterStmt(ast::SimpleIterStmt *statement);
             void visitForStmt(ast::ForStmt *statement);
@@ -142,6 +194,9 @@ namespace hpc {
             void visitVarRef(ast::VarRef *varRef);
             void visitFunctionCall(ast::FunctionCall *functionCall);
             void visitFieldRef(ast::FieldRef *fieldRef);
+            void visitSubscriptExpr(ast::SubscriptExpr *subscript);
+            void visitLengthExpr(ast::LengthExpr *length);
+            void visitShuffleExpr(ast::ShuffleExpr *shuffle);
             
             void visitCharLiteral(ast::CharLiteral *literal) {  }
             void visitIntegerLiteral(ast::IntegerLiteral *literal) {  }
@@ -16,6 +16,8 @@
 #include <hpc/ast/types/base.h>
 #include <hpc/ast/types/builtintype.h>
 #include <hpc/ast/types/pointertype.h>
+#include <hpc/ast/types/vectortype.h>
+#include <hpc/ast/types/arraytype.h>
 #include <hpc/ast/types/compoundtype.h>
 #include <hpc/ast/decls/declaration.h>
 #include <hpc/ast/decls/namespace.h>
@@ -31,6 +33,7 @@
 #include <hpc/ast/exprs/unary.h>
 #include <hpc/ast/exprs/reference.h>
 #include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/shuffle.h>
 #include <hpc/ast/exprs/constant.h>
 #include <hpc/ast/stmt/statement.h>
 #include <hpc/ast/stmt/ifelse.h>
@@ -109,7 +109,7 @@ namespace hpc {
             /*!
              \brief Create a class declaration and adds it in the current insert unit.
              */
-            ast::ClassDecl *createClassDecl(std::string className, ast::Symbol *superClass = nullptr, std::vector<ast::Symbol *> protocols = {});
+            ast::ClassDecl *createClassDecl(std::string className, ast::ClassDecl::ClassAttributes attributes = {}, ast::Symbol *superClass = nullptr, std::vector<ast::Symbol *> protocols = {});
             
         };
         
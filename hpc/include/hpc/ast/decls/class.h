@@ -27,6 +27,22 @@ namespace hpc {
         class ClassDecl : public NameSpaceDecl {
             friend class ClassType;
             
+        public:
+            /*!
+             \brief A structure containing additional attributes for a class used by the compiler.
+             */
+            struct ClassAttributes {
+                bool pinned = false;            ///< Pinned classes keep their fields in declaration order in memory, for interoperability with C structures.
+                bool packed = false;            ///< Packed classes have no padding between fields, and their fields may be misaligned.
+                unsigned alignment = 0;         ///< The alignment in bytes requested for the class objects, or 0 for their natural alignment.
+                bool cacheLineAligned = false;  ///< Whether the class objects are aligned to the cache line size of the target.
+                unsigned paddedTo = 0;          ///< The size of the class objects is rounded up to a multiple of this number of bytes, if not 0.
+                bool cacheLinePadded = false;   ///< Whether the size of the class objects is rounded up to a multiple of the cache line size of the target.
+                
+                ClassAttributes() {  }
+            };
+            
+        private:
             /*!
              \brief The class superclass.
              */
@@ -46,8 +62,13 @@ namespace hpc {
             
             ClassType *classType;
             
+            /*!
+             \brief A \c ClassAttributes structure describing all the additional attributes that can be given to a class.
+             */
+            ClassAttributes cattrs;
+            
         public:
-            ClassDecl(std::string name, std::string base = "", std::vector<std::string> protocols = {});
+            ClassDecl(std::string name, ClassAttributes cattrs = {}, std::string base = "", std::vector<std::string> protocols = {});
             virtual ~ClassDecl() {  }
             
             inline const std::vector<Decl *> &getMembers() const { return members; }
@@ -55,6 +76,33 @@ namespace hpc {
             inline const std::vector<FieldDecl *> &getFields() const { return fieldv; }
             
             inline ClassType *getType() const { return classType; }
+            
+            /*!
+             \brief Returns whether the fields of this class must be kept in declaration order in memory.
+             */
+            inline bool isPinned() const { return cattrs.pinned; }
+            /*!
+             \brief Returns whether the fields of this class are laid out with no padding between them.
+             */
+            inline bool isPacked() const { return cattrs.packed; }
+            /*!
+             \brief Returns the alignment in bytes requested for this class, or 0 if none was given.
+             \note Classes aligned to the cache line return 0 here, as the cache line size depends on the target.
+             */
+            inline unsigned getRequestedAlignment() const { return cattrs.alignment; }
+            /*!
+             \brief Returns whether this class is aligned to the cache line size of the target.
+             */
+            inline bool isCacheLineAligned() const { return cattrs.cacheLineAligned; }
+            /*!
+             \brief Returns the number of bytes the size of this class must be a multiple of, or 0 if none was given.
+             \note Classes padded to the cache line return 0 here, as the cache line size depends on the target.
+             */
+            inline unsigned getRequestedPadding() const { return cattrs.paddedTo; }
+            /*!
+             \brief Returns whether the size of this class is rounded up to a multiple of the cache line size of the target.
+             */
+            inline bool isCacheLinePadded() const { return cattrs.cacheLinePadded; }
 
             FieldDecl *getFieldDecl(std::string memberid);
             
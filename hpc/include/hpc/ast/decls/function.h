@@ -30,6 +30,7 @@ namespace hpc {
              */
             struct FunctionAttributes {
                 bool nostalgic = false;     ///< Nostalgic function will be linked as C functions, without being mangled.
+                bool rarely = false;        ///< Rarely called functions are optimized for size and placed apart from the frequently executed code.
                 //bool onewayf = false;     ///< Oneway functions will be called asynchronously
                 
                 FunctionAttributes() {  }
@@ -62,6 +63,10 @@ namespace hpc {
              \brief The number of \c return statements contained in the function block. This member is a cache for the \c containedReturns() method.
              */
             int retcount = -1;
+            /*!
+             \brief Whether this function makes slices of the arrays in its stack frame, so that the functions it calls may access its stack.
+             */
+            bool stackSliced = false;
             
             /*!
              \brief A \c FunctionAttributes structure describing all the additional attributes that can be given to a function.
@@ -116,6 +121,13 @@ namespace hpc {
              \brief Returns the number of \c return statements contained in the function statements block.
              */
             int containedReturns();
+            
+            /*!
+             \brief Returns whether this function makes slices of its local arrays, so that its calls cannot be tail calls.
+             */
+            inline bool slicesStack() const { return stackSliced; }
+            
+            inline void setSlicesStack(bool sliced) { stackSliced = sliced; }
 
             /*!
              \brief A boolean indicating whether this function has the qualified name to be the program's main function.
@@ -129,6 +141,12 @@ namespace hpc {
              */
             bool isNostalgic() const;
             
+            /*!
+             \brief A boolean indicating whether this function is marked as \c rarely called.
+             \note The branches leading to a call to a \c rarely function are expected not to be taken.
+             */
+            bool isRarelyCalled() const;
+            
             
             llvm_rtti_impl(FunctionDecl);
         };
@@ -92,6 +92,12 @@ namespace hpc {
             
             void setInitialValue(Expr *newVal) { initval = newVal; }
             
+            /*!
+             \brief Returns whether the initial value is known at compile time, so that it needs no global initialization function at program startup.
+             \note The initial value must have been validated.
+             */
+            bool hasConstantInitializer() const;
+            
             NameSpaceDecl *getContainer() const { return container; }
             
             
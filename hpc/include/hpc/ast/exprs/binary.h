@@ -52,6 +52,9 @@ namespace hpc {
             inline Expr *getLHS() const { return lhs; }
             inline Expr *getRHS() const { return rhs; }
             
+            inline void setLHS(Expr *newLHS) { lhs = newLHS; }
+            inline void setRHS(Expr *newRHS) { rhs = newRHS; }
+            
             virtual Type *evalType() = 0;
             
             inline lexer::token_ty getOperator() const { return oper; }
@@ -44,6 +44,8 @@ namespace hpc {
              \brief Returns the expression to be casted.
              */
             inline Expr *getExpression() const { return val; }
+            
+            inline void setExpression(Expr *newVal) { val = newVal; }
             /*!
              \brief Returns the type the value will be casted to.
              */
@@ -76,6 +78,8 @@ namespace hpc {
              */
             inline Expr *getExpression() const { return conditionVal; }
             
+            inline void setExpression(Expr *newVal) { conditionVal = newVal; }
+            
             virtual Type *evalType();
             
             
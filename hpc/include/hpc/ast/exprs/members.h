@@ -50,6 +50,8 @@ namespace hpc {
             
             inline Expr *getEntity() const { return entity; }
             
+            inline void setEntity(Expr *newEntity) { entity = newEntity; }
+            
             inline std::string getMemberIdentifier() const { return memberID; }
             
             inline FieldDecl *getDeclaration() const { return declaration; }
@@ -64,6 +66,80 @@ namespace hpc {
             llvm_rtti_impl(FieldRef);
         };
         
+        /*!
+         \brief An object describing the access to a single lane of a vector, or to a single element of an array or a slice.
+         */
+        class SubscriptExpr : public Expr {
+            
+            /*!
+             \brief The vector, array or slice with the element to access.
+             */
+            Expr *entity;
+            
+            /*!
+             \brief The index of the element to be accessed, starting from 0.
+             */
+            Expr *index;
+            
+        public:
+            /*!
+             \brief Initializes the element access with the entity and the element index.
+             */
+            SubscriptExpr(Expr *entity, Expr *index) : entity(entity), index(index) {  }
+            virtual ~SubscriptExpr() {  }
+            
+            inline Expr *getEntity() const { return entity; }
+            
+            inline void setEntity(Expr *newEntity) { entity = newEntity; }
+            
+            inline Expr *getIndex() const { return index; }
+            
+            inline void setIndex(Expr *newIndex) { index = newIndex; }
+            
+            virtual Type *evalType();
+            
+            /*!
+             \brief Returns whether the element can be assigned.
+             \note Elements of slices are always assignable, while lanes of vectors and elements of arrays are assignable only if the whole entity is.
+             */
+            virtual bool supportsLeftHandAssignment() const;
+            
+            /*!
+             \brief Returns whether the element belongs to an array stored by columns, so that each of its fields is stored in a different place.
+             */
+            bool isColumnAccess() const;
+            
+            
+            llvm_rtti_impl(SubscriptExpr);
+        };
+        
+        /*!
+         \brief An object describing the number of elements of an array or a slice (<tt>length of entity</tt>).
+         */
+        class LengthExpr : public Expr {
+            
+            /*!
+             \brief The array or slice whose elements are counted.
+             */
+            Expr *entity;
+            
+        public:
+            LengthExpr(Expr *entity) : entity(entity) {  }
+            virtual ~LengthExpr() {  }
+            
+            inline Expr *getEntity() const { return entity; }
+            
+            inline void setEntity(Expr *newEntity) { entity = newEntity; }
+            
+            /*!
+             \brief Returns the type of lengths, which is \c long.
+             */
+            virtual Type *evalType();
+            
+            
+            llvm_rtti_impl(LengthExpr);
+        };
+        
     }
 }
 
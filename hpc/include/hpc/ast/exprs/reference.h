@@ -89,6 +89,11 @@ namespace hpc {
             
             void castActualParamToType(int i, ast::Type *destination);
             
+            /*!
+             \brief Replaces the i-th value passed to the function with the given expression.
+             */
+            inline void setActualParam(int i, Expr *newParam) { actualParams[i] = newParam; }
+            
             virtual Type *evalType();
             
             /*!
@@ -0,0 +1,88 @@
+// => hpc/ast/exprs/shuffle.h
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#ifndef __human_plus_compiler_ast_shuffle
+#define __human_plus_compiler_ast_shuffle
+
+#include <hpc/ast/exprs/expression.h>
+
+#include <vector>
+
+namespace hpc {
+    namespace ast {
+        
+        /*!
+         \brief An object describing a new vector made of lanes picked from one or two vectors of the same type.
+         \note Lanes are numbered from the first lane of the first vector to the last lane of the second vector.
+         */
+        class ShuffleExpr : public Expr {
+            
+            /*!
+             \brief The values given to the \c shuffle expression: one or two vectors, followed by the lane indices.
+             */
+            std::vector<Expr *> arguments;
+            
+            /*!
+             \brief The number of vectors at the beginning of \c arguments.
+             \note This is 0 until the object is validated.
+             */
+            unsigned numVectors = 0;
+            
+            /*!
+             \brief The lane picked for each lane of the new vector.
+             \note This is empty until the object is validated.
+             */
+            std::vector<unsigned> mask;
+            
+            /*!
+             \brief The type of the new vector.
+             \note This is \c nullptr until the object is validated.
+             */
+            Type *resultType = nullptr;
+            
+        public:
+            ShuffleExpr() {  }
+            virtual ~ShuffleExpr() {  }
+            
+            inline const std::vector<Expr *> &getArguments() const { return arguments; }
+            
+            inline void addArgument(Expr *argument) { arguments.push_back(argument); }
+            
+            inline void setArgument(unsigned i, Expr *newArgument) { arguments[i] = newArgument; }
+            
+            /*!
+             \brief Returns the first vector to pick lanes from.
+             */
+            inline Expr *getFirstVector() const { return arguments[0]; }
+            /*!
+             \brief Returns the second vector to pick lanes from, or \c nullptr if lanes are picked from the first vector only.
+             */
+            inline Expr *getSecondVector() const { return numVectors > 1 ? arguments[1] : nullptr; }
+            
+            inline const std::vector<unsigned> &getMask() const { return mask; }
+            
+            /*!
+             \brief Sets the number of vectors given to the expression, the lanes they are shuffled with, and the type of the result.
+             */
+            inline void setShuffle(unsigned vectors, std::vector<unsigned> newMask, Type *type) {
+                numVectors = vectors;
+                mask = newMask;
+                resultType = type;
+            }
+            
+            virtual Type *evalType() { return resultType; }
+            
+            
+            llvm_rtti_impl(ShuffleExpr);
+        };
+        
+    }
+}
+
+#endif
@@ -40,6 +40,8 @@ namespace hpc {
             
             inline Expr *getOperand() const { return exp; }
             
+            inline void setOperand(Expr *newOperand) { exp = newOperand; }
+            
             /*!
              \brief Replaces the operand with its casting expression to boolean.
              */
@@ -21,10 +21,21 @@ namespace hpc {
     namespace ast {
         
         class IfStmt : public Stmt {
+        public:
+            /*!
+             \brief The outcome of the condition expected by the programmer.
+             */
+            typedef enum {
+                NoHint,
+                Likely,
+                Unlikely
+            } BranchHint;
+            
+        private:
             /*!
              \brief The expression as condition for the \c if statement.
              */
-            EvalExpr *condition;
+            Expr *condition;
             /*!
              \brief The statement that will be executed if the condition is \c true.
              */
@@ -33,6 +44,10 @@ namespace hpc {
              \brief The statement that will be executed if the condition is \c false, or \c nullptr if there is no \c else clause.
              */
             Stmt *elseBlock;
+            /*!
+             \brief Whether the condition has been marked as \c likely or \c unlikely to be \c true.
+             */
+            BranchHint hint = NoHint;
             
         public:
             /*!
@@ -45,12 +60,17 @@ namespace hpc {
             virtual ~IfStmt() {  }
             
             inline Expr *getCondition() const { return condition; }
+            inline void setCondition(Expr *newCondition) { condition = newCondition; }
             
             inline Stmt *getThenBlock() const { return thenBlock; }
             inline Stmt *getElseBlock() const { return elseBlock; }
             
             inline bool hasElseBlock() const { return elseBlock != nullptr; }
             
+            inline BranchHint getBranchHint() const { return hint; }
+            
+            inline void setBranchHint(BranchHint newHint) { hint = newHint; }
+            
             virtual bool returns() const;
             virtual int containedReturns() const;
             
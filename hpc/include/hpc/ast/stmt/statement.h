@@ -161,6 +161,10 @@ namespace hpc {
              \brief The value this statement will return, or \c nullptr for void returns.
              */
             Expr *returnVal;
+            /*!
+             \brief Whether the returned call has been requested to be a tail call, with <tt>as tail call</tt>.
+             */
+            bool tailCallRequired = false;
             
         public:
             /*!
@@ -173,8 +177,14 @@ namespace hpc {
             
             inline Expr *getReturnValue() const { return returnVal; }
             
+            inline void setReturnValue(Expr *newVal) { returnVal = newVal; }
+            
             void castReturnValueToType(ast::Type *destination);
             
+            inline bool isTailCallRequired() const { return tailCallRequired; }
+            
+            inline void setTailCallRequired(bool required) { tailCallRequired = required; }
+            
             virtual bool returns() const { return true; }
             virtual int containedReturns() const { return 1; }
             
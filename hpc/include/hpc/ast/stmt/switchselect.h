@@ -14,11 +14,46 @@
 
 #include <vector>
 
-#include <llvm/IR/Value.h>
-
 namespace hpc {
     namespace ast {
         
+        class SwitchStmt;
+        
+        /*!
+         \brief An object describing a \c case or \c default label in the block of a \c switch statement.
+         \note The statements following the label are executed until a \c break statement, falling through the next labels.
+         */
+        class CaseStmt : public Stmt {
+            /*!
+             \brief The values selecting this label, or an empty \c std::vector for the \c default label.
+             */
+            std::vector<Expr *> values;
+            /*!
+             \brief The switch statement this label belongs to, or \c nullptr if it has not been validated yet.
+             */
+            SwitchStmt *container = nullptr;
+            
+        public:
+            /*!
+             \brief Initializes the label with the values selecting it. An empty \c std::vector initializes a \c default label.
+             */
+            CaseStmt(const std::vector<Expr *> &values);
+            virtual ~CaseStmt() {  }
+            
+            inline const std::vector<Expr *> &getValues() const { return values; }
+            
+            inline void setValue(unsigned i, Expr *newValue) { values[i] = newValue; }
+            
+            inline bool isDefault() const { return values.empty(); }
+            
+            inline SwitchStmt *getSwitch() const { return container; }
+            
+            inline void setSwitch(SwitchStmt *newSwitch) { container = newSwitch; }
+            
+            
+            llvm_rtti_impl(CaseStmt);
+        };
+        
         /*!
          \brief An object describing a compound selection statement.
          */
@@ -30,21 +65,44 @@ namespace hpc {
             /*!
              \brief The block containing the cases to be selected.
              */
-            Stmt *block;
+            CompoundStmt *block;
+            /*!
+             \brief Whether the block contains a \c default label.
+             */
+            bool hasDefault = false;
+            /*!
+             \brief Whether a \c break statement leaves this statement.
+             */
+            bool broken = false;
             
         public:
             /*!
              \brief Initializes the compound selection statement with the selection value and the block.
              */
-            SwitchStmt(Expr *selectionVal, Stmt *block);
+            SwitchStmt(Expr *selectionVal, CompoundStmt *block);
             virtual ~SwitchStmt() {  }
             
             inline Expr *getSelectionValue() const { return selectionVal; }
             
-            inline Stmt *getBlock() const { return block; }
+            inline void setSelectionValue(Expr *newValue) { selectionVal = newValue; }
+            
+            inline CompoundStmt *getBlock() const { return block; }
+            
+            inline bool hasDefaultCase() const { return hasDefault; }
+            
+            inline void setHasDefaultCase(bool newHasDefault) { hasDefault = newHasDefault; }
+            
+            inline bool isBroken() const { return broken; }
+            
+            inline void setBroken(bool newBroken) { broken = newBroken; }
+            
+            virtual bool returns() const;
+            virtual int containedReturns() const;
+            
+            virtual break_target getBreakRole() const { return BreakSwitch; }
             
             
-            //llvm_rtti_impl(SwitchStmt);
+            llvm_rtti_impl(SwitchStmt);
         };
         
     }
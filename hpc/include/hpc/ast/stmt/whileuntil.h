@@ -19,6 +19,44 @@
 namespace hpc {
     namespace ast {
         
+        /*!
+         \brief The optimizations requested for a loop by the directives following the \c loop keyword.
+         */
+        struct LoopDirectives {
+            /*!
+             \brief Whether the loop must be vectorized.
+             */
+            bool vectorize = false;
+            /*!
+             \brief The number of lanes of the vectorized loop, or \c 0 to let the optimizer choose it.
+             */
+            unsigned vectorizeWidth = 0;
+            /*!
+             \brief The number of iterations to interleave, or \c 0 if not requested.
+             */
+            unsigned interleaveCount = 0;
+            /*!
+             \brief Whether the loop must be unrolled.
+             */
+            bool unroll = false;
+            /*!
+             \brief The number of times the loop body is replicated, or \c 0 to let the optimizer choose it.
+             */
+            unsigned unrollCount = 0;
+            /*!
+             \brief Whether the loop must be unrolled completely.
+             */
+            bool unrollFully = false;
+            /*!
+             \brief Whether no iteration accesses the memory written by another iteration, so that iterations may run in any order.
+             */
+            bool independent = false;
+            
+            inline bool empty() const {
+                return !vectorize && !interleaveCount && !unroll && !independent;
+            }
+        };
+        
         /*!
          \brief Base abstract class for all the simple iteration statements such as \c while, \c until, \c do-while and \c do-until.
          */
@@ -33,11 +71,15 @@ namespace hpc {
             /*!
              \brief The condition for the iteration.
              */
-            EvalExpr *condition;
+            Expr *condition;
             /*!
              \brief The block that will be executed by the iteration.
              */
             Stmt *block;
+            /*!
+             \brief The optimization directives given to the loop.
+             */
+            LoopDirectives directives;
             
         public:
             /*!
@@ -47,9 +89,13 @@ namespace hpc {
             virtual ~SimpleIterStmt() {  }
             
             inline Expr *getCondition() const { return condition; }
+            inline void setCondition(Expr *newCondition) { condition = newCondition; }
             
             inline Stmt *getBlock() const { return block; }
             
+            inline const LoopDirectives &getDirectives() const { return directives; }
+            inline void setDirectives(const LoopDirectives &directives) { this->directives = directives; }
+            
             virtual bool returns() const;
             virtual int containedReturns() const;
 
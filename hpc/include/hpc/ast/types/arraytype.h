@@ -0,0 +1,121 @@
+// => hpc/ast/types/arraytype.h
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#ifndef __human_plus_compiler_ast_type_array
+#define __human_plus_compiler_ast_type_array
+
+#include <hpc/ast/types/base.h>
+
+#include <llvm/IR/Type.h>
+
+namespace hpc {
+    namespace ast {
+        
+        /*!
+         \brief Class for type instances of fixed-size arrays, holding a number of elements known at compile-time one after the other.
+         */
+        class ArrayType : public Type {
+            /*!
+             \brief The type of each element. May not be canonical.
+             */
+            Type *elementType;
+            /*!
+             \brief The number of elements.
+             */
+            uint64_t length;
+            /*!
+             \brief Whether each field of the elements is stored in its own contiguous array (<tt>stored by columns</tt>), instead of storing the elements one after the other.
+             \note Only arrays of classes can be stored by columns. Such an array can't be seen through a slice, as its elements are not contiguous.
+             */
+            bool storedByColumns;
+            
+            
+            ArrayType(Type *elementType, uint64_t length, bool storedByColumns) : elementType(elementType), length(length), storedByColumns(storedByColumns) {  }
+            
+        public:
+            /*!
+             \brief Returns an array type with the given number of elements of the given type.
+             */
+            static ArrayType *get(Type *elementType, uint64_t length, bool storedByColumns = false);
+            
+            
+            inline Type *getCanonicalType() {
+                return get(elementType->getCanonicalType(), length, storedByColumns);
+            }
+            
+            inline bool isCanonicalType() const {
+                return elementType->isCanonicalType();
+            }
+            
+            inline TypeFormat getFormat() const { return TypeFormatArray; }
+            
+            bool canCastTo(Type *type, bool explicitly = false);
+            
+            bool canAssignTo(Type *type);
+            
+            
+            inline Type *getElementType() const { return elementType; }
+            
+            inline uint64_t getLength() const { return length; }
+            
+            inline bool isStoredByColumns() const { return storedByColumns; }
+            
+            std::string str(bool quoted = true);
+            
+
+            llvm_rtti_impl(ArrayType);
+        };
+        
+        /*!
+         \brief Class for type instances of slices, giving access to a number of contiguous elements known at run-time.
+         \note A slice does not own its elements: it is made of the address of the first element and the number of elements.
+         */
+        class SliceType : public Type {
+            /*!
+             \brief The type of each element. May not be canonical.
+             */
+            Type *elementType;
+            
+            
+            SliceType(Type *elementType) : elementType(elementType) {  }
+            
+        public:
+            /*!
+             \brief Returns a slice type with elements of the given type.
+             */
+            static SliceType *get(Type *elementType);
+            
+            
+            inline Type *getCanonicalType() {
+                return get(elementType->getCanonicalType());
+            }
+            
+            inline bool isCanonicalType() const {
+                return elementType->isCanonicalType();
+            }
+            
+            inline TypeFormat getFormat() const { return TypeFormatSlice; }
+            
+            bool canCastTo(Type *type, bool explicitly = false);
+            
+            bool canAssignTo(Type *type);
+            
+            
+            inline Type *getElementType() const { return elementType; }
+            
+            std::string str(bool quoted = true);
+            
+
+            llvm_rtti_impl(SliceType);
+        };
+        
+    }
+}
+
+#endif
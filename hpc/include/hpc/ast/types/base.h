@@ -30,11 +30,12 @@ namespace hpc {
             
             unsigned constQual : 1;
             unsigned volatileQual : 1;
+            unsigned exclusiveQual : 1;
             
         public:
-            TypeQualifiers() : constQual(0), volatileQual(0) {  }
+            TypeQualifiers() : constQual(0), volatileQual(0), exclusiveQual(0) {  }
             
-            inline bool isDefault() const { return isConstant() && isVolatile(); }
+            inline bool isDefault() const { return !isConstant() && !isVolatile() && !isExclusive(); }
             
             void setConstant(bool newConstQual) {
                 constQual = newConstQual;
@@ -48,6 +49,10 @@ namespace hpc {
                 return volatileQual;
             }
             
+            void setExclusive(bool newExclusiveQual) { exclusiveQual = newExclusiveQual; }
+            
+            inline bool isExclusive() const { return exclusiveQual; }
+            
         };
         
         /*!
@@ -90,6 +95,18 @@ namespace hpc {
              \brief Value indicating that the associated type is a memory address.
              */
             TypeFormatPointer,
+            /*!
+             \brief Value indicating that the associated type is a fixed-width vector of scalar types.
+             */
+            TypeFormatVector,
+            /*!
+             \brief Value indicating that the associated type is a fixed-size array of elements laid out contiguously.
+             */
+            TypeFormatArray,
+            /*!
+             \brief Value indicating that the associated type is a view on contiguous elements, made of their address and their number.
+             */
+            TypeFormatSlice,
             /*!
              \brief Value indicating that the associated type is a function pointer.
              */
@@ -108,7 +125,11 @@ namespace hpc {
             /*!
              \brief \c volatile qualifier.
              */
-            TypeQualVolatile = 1 << 1
+            TypeQualVolatile = 1 << 1,
+            /*!
+             \brief \c exclusive qualifier.
+             */
+            TypeQualExclusive = 1 << 2
         } TypeQuals;
         
         
@@ -206,6 +227,23 @@ namespace hpc {
              \brief Returns whether this type is a null pointer type.
              */
             inline bool isNullPointerType() const { return isPointerType() && !getPointedType(); }
+            /*!
+             \brief Returns whether this type is a vector type.
+             */
+            inline bool isVectorType() const { return getFormat() == TypeFormatVector; }
+            /*!
+             \brief Returns whether this type is a fixed-size array type.
+             */
+            inline bool isArrayType() const { return getFormat() == TypeFormatArray; }
+            /*!
+             \brief Returns whether this type is a slice type.
+             */
+            inline bool isSliceType() const { return getFormat() == TypeFormatSlice; }
+            /*!
+             \brief Returns the type of the lanes if this type is a vector type, or this type otherwise.
+             \note Operations on vectors work lane by lane, so they are checked and built as the same operations on their scalar type.
+             */
+            Type *getScalarType();
             
             /*!
              \brief Returns an \c ast::Type object which should be used when a type cannot be determined.
@@ -234,6 +272,12 @@ namespace hpc {
              */
             virtual bool isConstant() const { return false; }
             
+            /*!
+             \brief Returns whether the memory accessed through the pointers or slices of this type is not accessed through any other variable while they live (\c exclusive ).
+             \note This is a promise about the variables, not a different type, so canonical types are never exclusive.
+             */
+            virtual bool isExclusive() const { return false; }
+            
             /*!
              \brief Returns a boolean indicating whether the two given types represent the exact same type.
              */
@@ -309,6 +353,11 @@ namespace hpc {
                 return theType->isConstant();
             }
             
+            virtual inline bool isExclusive() const {
+                assert(theType && "No type found.");
+                return theType->isExclusive();
+            }
+            
             llvm_rtti_impl_superclass(TypeEncloser);
             
         };
@@ -376,9 +425,10 @@ namespace hpc {
         class QualifiedType : public TypeEncloser {
             
             unsigned constQual : 1;
+            unsigned exclusiveQual : 1;
 
         public:
-            QualifiedType(Type *theType = nullptr) : TypeEncloser(theType) {  }
+            QualifiedType(Type *theType = nullptr) : TypeEncloser(theType), constQual(0), exclusiveQual(0) {  }
             
             void setType(Type *newType) { setEnclosingType(newType); }
             
@@ -386,7 +436,13 @@ namespace hpc {
             
             inline bool isConstant() const { return constQual; }
             
+            void setExclusive(bool newExclusiveQual) { exclusiveQual = newExclusiveQual; }
+            
+            inline bool isExclusive() const { return exclusiveQual || TypeEncloser::isExclusive(); }
+            
             Type *getCanonicalType();
+            
+            inline bool isCanonicalType() const { return !exclusiveQual && TypeEncloser::isCanonicalType(); }
 
             /*!
              \brief Creates a new QualifiedType object with the same qualifiers enclosing the given type.
@@ -0,0 +1,77 @@
+// => hpc/ast/types/vectortype.h
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#ifndef __human_plus_compiler_ast_type_vector
+#define __human_plus_compiler_ast_type_vector
+
+#include <hpc/ast/types/base.h>
+
+#include <llvm/IR/Type.h>
+
+namespace hpc {
+    namespace ast {
+        
+        /*!
+         \brief Class for type instances of fixed-width vector types, holding a number of lanes of a scalar type that are operated on together.
+         \note Vectors of booleans are masks, produced by the comparison of two vectors.
+         */
+        class VectorType : public Type {
+            /*!
+             \brief The type of each lane. May not be canonical.
+             */
+            Type *elementType;
+            /*!
+             \brief The number of lanes.
+             */
+            unsigned lanes;
+            
+            
+            VectorType(Type *elementType, unsigned lanes) : elementType(elementType), lanes(lanes) {  }
+            
+        public:
+            /*!
+             \brief Returns a vector type with the given number of lanes of the given type.
+             */
+            static VectorType *get(Type *elementType, unsigned lanes);
+            
+            
+            inline Type *getCanonicalType() {
+                return get(elementType->getCanonicalType(), lanes);
+            }
+            
+            inline bool isCanonicalType() const {
+                return elementType->isCanonicalType();
+            }
+            
+            inline TypeFormat getFormat() const { return TypeFormatVector; }
+            
+            bool canCastTo(Type *type, bool explicitly = false);
+            
+            bool canAssignTo(Type *type);
+            
+            
+            inline Type *getElementType() const { return elementType; }
+            
+            inline unsigned getNumLanes() const { return lanes; }
+            
+            /*!
+             \brief Returns whether the lanes of this vector are booleans, as produced by comparisons.
+             */
+            inline bool isMaskType() const { return elementType->isBooleanType(); }
+            
+            std::string str(bool quoted = true);
+            
+
+            llvm_rtti_impl(VectorType);
+        };
+        
+    }
+}
+
+#endif
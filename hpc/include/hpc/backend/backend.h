@@ -15,6 +15,7 @@
 #include <hpc/utils/files.h>
 #include <hpc/utils/opts.h>
 
+#include <llvm/IR/DiagnosticInfo.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
@@ -81,6 +82,12 @@ namespace hpc {
              */
             llvm::Module *boundmodule = nullptr;
             
+            /*!
+             \brief Reports the loop directives the optimizer could not honor as warnings, and prints any other LLVM diagnostic as LLVM would.
+             \param context The backend helper the module being optimized is bound to.
+             */
+            static void handleDiagnostic(const llvm::DiagnosticInfo &info, void *context);
+            
         public:
             /*!
              \brief Initializes the helper with the type of output for the backend.
@@ -242,6 +242,57 @@ namespace hpc {
              \brief The lexer finished the file in the middle of a parsing process.
              */
             UnexpectedEOF                       = 224,
+            /*!
+             \brief The parser has not found the \c class keyword after class attributes, as expected.
+             */
+            ExpectedTokenClass                  = 225,
+            /*!
+             \brief The parser has not found a number of bytes or \c cacheline after a class attribute taking a size, as expected.
+             \param 0 The class attribute
+             */
+            ExpectedClassAttributeValue         = 226,
+            /*!
+             \brief The parser has not found the number of lanes of a vector type, as expected.
+             */
+            ExpectedVectorLanes                 = 227,
+            /*!
+             \brief The parser has not found a closed bracket after a lane index, as expected.
+             */
+            ExpectedClosedBracket               = 228,
+            /*!
+             \brief The parser has not found the number of elements of an array type, as expected.
+             */
+            ExpectedArrayLength                 = 229,
+            /*!
+             \brief The parser has not found <tt>by columns</tt> after \c stored in an array type, as expected.
+             */
+            ExpectedStorageOrder                = 230,
+            /*!
+             \brief The parser has not found ':' after the values of a \c case label or after \c default, as expected.
+             */
+            ExpectedColonAfterCase              = 231,
+            /*!
+             \brief The parser has not found <tt>tail call</tt> after \c as in a \c return statement, as expected.
+             */
+            ExpectedTailCall                    = 232,
+            /*!
+             \brief The parser has not found \c vectorize, \c interleave, \c unroll or \c independent in the directives of a \c loop, as expected.
+             */
+            ExpectedLoopDirective               = 233,
+            /*!
+             \brief The parser has not found a positive number after \c by in a \c loop directive, as expected.
+             \param 0 The directive identifier
+             */
+            ExpectedDirectiveCount              = 234,
+            /*!
+             \brief The width requested by a \c vectorize directive is not a power of two.
+             \param 0 The requested width
+             */
+            InvalidVectorizeWidth               = 235,
+            /*!
+             \brief The parser has not found an iteration statement after the directives of a \c loop, as expected.
+             */
+            ExpectedIterationAfterLoop          = 236,
             
             
             //
@@ -387,13 +438,170 @@ namespace hpc {
              \brief The parsed type has 'unsigned' or 'signed' qualifier but it's not an integer type.
              */
             TypeCannotBeSignedOrUnsigned         = 328,
+            /*!
+             \brief The size given to an \c aligned or \c padded class attribute is not a power of two.
+             \param 0 The class attribute
+             \param 1 The given size
+             \param 2 The class identifier
+             */
+            ClassAttributeNotPowerOfTwo          = 329,
+            /*!
+             \brief The alignment requested for a class is greater than the maximum alignment supported by LLVM.
+             \param 0 The requested alignment
+             \param 1 The class identifier
+             \param 2 The maximum alignment
+             */
+            ClassAlignmentTooLarge               = 330,
+            /*!
+             \brief The lanes of a vector type are not booleans or numbers.
+             \param 0 The element type
+             */
+            InvalidVectorElementType             = 331,
+            /*!
+             \brief An index is applied to a value which is not a vector, an array or a slice.
+             \param 0 The type of the value
+             */
+            SubscriptOfInvalidType               = 332,
+            /*!
+             \brief An index applied to a vector, an array or a slice is not an integer.
+             \param 0 The type of the index
+             */
+            IndexNotInteger                      = 333,
+            /*!
+             \brief A constant lane index is greater than the last lane of the vector.
+             \param 0 The lane index
+             \param 1 The number of lanes
+             */
+            LaneIndexOutOfRange                  = 334,
+            /*!
+             \brief A value given to a \c shuffle expression is not a vector.
+             \param 0 The type of the value
+             */
+            ShuffleOperandNotVector              = 335,
+            /*!
+             \brief A lane index given to a \c shuffle expression is not an integer literal.
+             */
+            ShuffleIndexNotConstant              = 336,
+            /*!
+             \brief The two vectors given to a \c shuffle expression have different types.
+             \param 0 The type of the first vector
+             \param 1 The type of the second vector
+             */
+            ShuffledVectorsMismatch              = 337,
+            /*!
+             \brief A constant index is greater than the last element of the array.
+             \param 0 The index
+             \param 1 The number of elements
+             */
+            ArrayIndexOutOfBounds                = 338,
+            /*!
+             \brief The length of a value which is not an array or a slice is requested.
+             \param 0 The type of the value
+             */
+            LengthOfInvalidType                  = 339,
+            /*!
+             \brief The elements of an array or a slice are declared \c void.
+             */
+            VoidArrayElementType                 = 340,
+            /*!
+             \brief An array stored by columns does not have elements of a class type.
+             \param 0 The type of the elements
+             */
+            ColumnsOfNonClassType                = 341,
+            /*!
+             \brief The \c exclusive qualifier is applied to a type which is not a pointer or a slice.
+             \param 0 The qualified type
+             */
+            ExclusiveNonPointerType              = 342,
+            /*!
+             \brief A global variable or a class field is declared \c exclusive.
+             \param 0 The variable identifier
+             */
+            ExclusiveGlobalVariable              = 343,
+            /*!
+             \brief The value selecting a label of a \c switch statement is not an integer.
+             \param 0 The type of the value
+             */
+            SwitchValueNotInteger                = 344,
+            /*!
+             \brief A \c case or \c default label is not directly in the block of a \c switch statement.
+             */
+            CaseNotInSwitch                      = 345,
+            /*!
+             \brief A value of a \c case label is not an integer or character literal.
+             */
+            CaseValueNotConstant                 = 346,
+            /*!
+             \brief A value appears in more than one \c case label of the same \c switch statement.
+             \param 0 The duplicated value
+             */
+            DuplicateCaseValue                   = 347,
+            /*!
+             \brief A \c switch statement has more than one \c default label.
+             */
+            MultipleDefaultCases                 = 348,
+            /*!
+             \brief The value of a \c return statement requested as a tail call is not a function call.
+             */
+            TailCallNotACall                     = 349,
+            /*!
+             \brief A function is requested as a tail call of a function with different return or parameter types.
+             \param 0 The called function identifier
+             \param 1 The calling function identifier
+             */
+            TailCallSignatureMismatch            = 350,
+            /*!
+             \brief A tail call is requested in a function making slices of its local arrays, which the called function could access.
+             \param 0 The calling function identifier
+             */
+            TailCallSlicesStack                  = 351,
+            /*!
+             \brief A value of a \c case label is not a value of the type of the \c switch value.
+             \param 0 The case value
+             \param 1 The type of the switch value
+             */
+            CaseValueOutOfRange                  = 352,
             
             
             //
             // Warnings (1xxx)
             //
             
-            // Nothing yet.
+            /*!
+             \brief A function parameter has a class type, so the whole object is copied on every call (-Wperformance).
+             \param 0 The parameter identifier
+             \param 1 The parameter type
+             */
+            ClassParameterPassedByValue         = 1001,
+            /*!
+             \brief A loop condition calls a function without side effects, with arguments that do not change in the loop, so the same call is repeated on every iteration (-Wperformance).
+             \param 0 The function identifier
+             */
+            LoopInvariantCallInCondition        = 1002,
+            /*!
+             \brief An implicit widening conversion is performed inside a loop, on every iteration (-Wperformance).
+             \param 0 The original type
+             \param 1 The destination type
+             */
+            ImplicitWideningCastInLoop          = 1003,
+            /*!
+             \brief The initial value of a global variable is not a constant, so it is computed by a global initialization function at program startup (-Wperformance).
+             \param 0 The variable identifier
+             */
+            GlobalInitializerNotConstant        = 1004,
+            /*!
+             \brief The alignment requested for a class is lower than the alignment of its fields on the target, so it has no effect.
+             \param 0 The requested alignment
+             \param 1 The class identifier
+             \param 2 The natural alignment of the class
+             */
+            ClassAlignmentBelowNatural          = 1005,
+            /*!
+             \brief The optimizer could not apply the directives given to a loop.
+             \param 0 The function identifier
+             \param 1 The reason given by the optimizer
+             */
+            LoopDirectiveNotHonored             = 1006,
             
             
             //
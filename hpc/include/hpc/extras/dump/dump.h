@@ -88,6 +88,8 @@ namespace hpc {
             void visitBreakStmt(ast::BreakStmt *statement);
             void visitContinueStmt(ast::ContinueStmt *statement);
             void visitIfStmt(ast::IfStmt *statement);
+            void visitSwitchStmt(ast::SwitchStmt *statement);
+            void visitCaseStmt(ast::CaseStmt *statement);
             void visitSimpleIterStmt(ast::SimpleIterStmt *statement);
             void visitPreWhileStmt(ast::PreWhileStmt *statement);
             void visitPreUntilStmt(ast::PreUntilStmt *statement);
@@ -113,6 +115,9 @@ namespace hpc {
             void visitVarRef(ast::VarRef *varRef);
             void visitFunctionCall(ast::FunctionCall *functionCall);
             void visitFieldRef(ast::FieldRef *fieldRef);
+            void visitSubscriptExpr(ast::SubscriptExpr *subscript);
+            void visitLengthExpr(ast::LengthExpr *length);
+            void visitShuffleExpr(ast::ShuffleExpr *shuffle);
             void visitGlobalVar(ast::GlobalVar *var);
             void visitLocalVar(ast::LocalVar *var);
             void visitParamVar(ast::ParamVar *var);
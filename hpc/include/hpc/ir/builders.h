@@ -15,12 +15,19 @@
 #include <hpc/ast/decls/variable.h>
 #include <hpc/target/target.h>
 #include <hpc/runtime/runtime.h>
+#include <hpc/analyzers/reachability/reachability.h>
+#include <hpc/analyzers/purity/purity.h>
+#include <hpc/analyzers/bounds/bounds.h>
 
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringMap.h>
 #include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/ValueHandle.h>
 
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
 
 namespace hpc {
     
@@ -36,39 +43,73 @@ namespace hpc {
          */
         class SymbolTable {
             
+            /*!
+             \brief The links of the AST components local to a function with their IR counterpart, which are dropped once the function is built.
+             */
+            struct FunctionTables {
+                /*!
+                 \brief It keeps the values of the parameters, the local variables and the expressions of the function.
+                 */
+                llvm::DenseMap<ast::Component *, llvm::Value *> componentTable;
+                /*!
+                 \brief It keeps all the links between a \c break receiver, and the block any break statement should jump to.
+                 \note Use \c setBreakBlock() and \c makeBreak()
+                 */
+                llvm::DenseMap<ast::Stmt *, llvm::BasicBlock *> breakTable;
+                /*!
+                 \brief It keeps all the links between a \c continue receiver, and the block any break statement should jump to.
+                 \note Use \c setContinueBlock() and \c makeContinue()
+                 */
+                llvm::DenseMap<ast::Stmt *, llvm::BasicBlock *> continueTable;
+            };
+            
             ModuleBuilder &moduleBuilder;
             
             /*!
-             \brief It keeps all the links between any already translated AST component with their IR counterpart.
+             \brief It keeps all the links between the functions and the global variables already translated with their IR counterpart.
              \note Use \c setValForComponent() and \c getValForComponent() to use this table.
              */
-            std::map<ast::Component *, llvm::Value *> componentTable;
+            llvm::DenseMap<ast::Component *, llvm::Value *> globalTable;
+            /*!
+             \brief The tables of the functions being built, the innermost being the last one.
+             \note Use \c pushFunction() and \c popFunction() around the body of a function.
+             */
+            std::vector<FunctionTables> functionTables;
             /*!
              \brief It keeps all the links between any already translated AST type with their IR counterpart.
              \note Use \c getIRType() and \c setIRType() to use this table.
              */
-            std::map<ast::Type *, llvm::Type *> typeTable;
-            
+            llvm::DenseMap<ast::Type *, llvm::Type *> typeTable;
             /*!
-             \brief It keeps all the links between the strings value and the string constants declared in the module being built.
-             \note Use \c getOrCreateStringConstant()
+             \brief It keeps the position of each field in the IR structure of its class, which may differ from the declaration order.
+             \note Use \c getFieldSlot() and \c setFieldSlot() to use this table.
              */
-            std::map<runtime::string_ty, llvm::GlobalVariable *> stringTable;
+            llvm::DenseMap<ast::FieldDecl *, unsigned> fieldTable;
+            
             /*!
-             \brief It keeps all the links between a \c break receiver, and the block any break statement should jump to.
-             \note Use \c setBreakBlock() and \c makeBreak()
+             \brief It keeps all the links between the strings value and the pointer to the string constants declared in the module being built.
+             \note Use \c getOrCreateStringConstant()
              */
-            std::map<ast::Stmt *, llvm::BasicBlock *> breakTable;
+            llvm::StringMap<llvm::Constant *> stringTable;
+            
             /*!
-             \brief It keeps all the links between a \c continue receiver, and the block any break statement should jump to.
-             \note Use \c setContinueBlock() and \c makeContinue()
+             \brief Returns the table holding the value of the given component: the module table for functions and global variables, the table of the innermost function otherwise.
              */
-            std::map<ast::Stmt *, llvm::BasicBlock *> continueTable;
+            llvm::DenseMap<ast::Component *, llvm::Value *> &getComponentTable(ast::Component *component);
             
             
         public:
             SymbolTable(ModuleBuilder &moduleBuilder);
             
+            /*!
+             \brief Starts the tables of a function whose body is being built, hiding the tables of the function being built before.
+             */
+            void pushFunction();
+            /*!
+             \brief Drops the tables of the innermost function being built, whose local values are no longer needed.
+             */
+            void popFunction();
+            
             void setValForComponent(ast::Component *component, llvm::Value *value);
             void setValForComponent(ast::Component &component, llvm::Value *value);
             
@@ -81,13 +122,22 @@ namespace hpc {
             llvm::Type *getIRType(ast::Type *type);
             llvm::Type *getIRType(ast::Type &type);
             
+            void setFieldSlot(ast::FieldDecl *field, unsigned slot);
+            /*!
+             \brief Returns the index of the given field in the IR structure of its class, building the structure if needed.
+             */
+            unsigned getFieldSlot(ast::FieldDecl *field);
+            
             llvm::Value *getOrCreateReference(ast::Component *component);
             llvm::Value *getOrCreateReference(ast::Component &component);
             
             void setBreakBlock(ast::Stmt &stmt, llvm::BasicBlock *block);
             void setContinueBlock(ast::Stmt &stmt, llvm::BasicBlock *block);
             
-            llvm::GlobalVariable *getOrCreateStringConstant(runtime::string_ty str);
+            /*!
+             \brief Returns a pointer to the first character of the constant holding \c str, declaring the constant the first time.
+             */
+            llvm::Constant *getOrCreateStringConstant(runtime::string_ty str);
             
             llvm::BranchInst *makeBreak(ast::Stmt *stmt);
             llvm::BranchInst *makeContinue(ast::Stmt *stmt);
@@ -122,6 +172,10 @@ namespace hpc {
              \brief The TargetInfo object containing info about the target we're generating code for.
              */
             target::TargetInfo &targetInfo;
+            /*!
+             \brief A copy of the data layout of the target, private to this builder since LLVM caches the layouts of structures in it.
+             */
+            llvm::DataLayout dataLayout;
             
             SymbolTable table;
             
@@ -133,12 +187,118 @@ namespace hpc {
              \brief The LLVM IR value that will be returned. This is \c nullptr unless the builder is building a function with more than one return statement.
              */
             llvm::Value *returnRegister = nullptr;
+            /*!
+             \brief The block calling \c llvm.trap when an access is out of bounds. This is \c nullptr until the function being built needs it.
+             */
+            llvm::BasicBlock *trapBlock = nullptr;
+            /*!
+             \brief The blocks being built in the current function, from the outermost to the innermost, with the variables they declare.
+             \note The variables live from the beginning to the end of their block, so their stack slots can be shared with the variables of disjoint blocks.
+             */
+            std::vector<std::pair<ast::CompoundStmt *, std::vector<ast::Var *>>> scopes;
+            /*!
+             \brief The alias scopes of the exclusive slices of the function being built, whose elements are accessed through no other variable.
+             */
+            std::map<ast::Var *, llvm::MDNode *> aliasScopes;
+            /*!
+             \brief Whether the scalar parameters and local variables are built directly in SSA form, instead of being kept in stack slots promoted later by LLVM.
+             */
+            bool directSSA = false;
+            /*!
+             \brief For each variable of the function being built in SSA form, its current value at the end of the blocks where it was assigned or read.
+             \note The handles follow the phis replaced by the value they forward.
+             */
+            std::map<ast::Var *, std::map<llvm::BasicBlock *, llvm::WeakTrackingVH>> ssaDefinitions;
+            /*!
+             \brief The blocks of the function being built whose predecessors are all known.
+             */
+            std::set<llvm::BasicBlock *> sealedBlocks;
+            /*!
+             \brief The phis created in the blocks not sealed yet, whose operands are added once the blocks are sealed.
+             */
+            std::map<llvm::BasicBlock *, std::vector<std::pair<ast::Var *, llvm::PHINode *>>> incompletePhis;
+            /*!
+             \brief The way the return value and the parameters of each function built are passed, according to the ABI of the target.
+             */
+            std::map<ast::FunctionDecl *, target::FunctionABIInfo> functionABIs;
             
             /*!
              \brief The LLVM IR builder used to create instructions. This is \c nullptr unless the builder is building a function.
              */
             InstructionBuilder *builder = nullptr;
             
+            /*!
+             \brief The state of the function being built, set aside while a function it calls is built.
+             */
+            struct FunctionState {
+                InstructionBuilder *builder;
+                llvm::BasicBlock *returnBlock;
+                llvm::Value *returnRegister;
+                llvm::BasicBlock *trapBlock;
+                std::vector<std::pair<ast::CompoundStmt *, std::vector<ast::Var *>>> scopes;
+                std::map<ast::Var *, llvm::MDNode *> aliasScopes;
+                std::map<ast::Var *, std::map<llvm::BasicBlock *, llvm::WeakTrackingVH>> ssaDefinitions;
+                std::set<llvm::BasicBlock *> sealedBlocks;
+                std::map<llvm::BasicBlock *, std::vector<std::pair<ast::Var *, llvm::PHINode *>>> incompletePhis;
+            };
+            
+            /*!
+             \brief Sets aside the state of the function being built, if any, and clears it for a new function.
+             \note The symbol table keeps its own stack of function tables.
+             */
+            FunctionState suspendFunction();
+            /*!
+             \brief Restores the state set aside by \c suspendFunction() once the function built in between is done.
+             */
+            void resumeFunction(FunctionState &state);
+            /*!
+             \brief The function initializing at program startup the global variables whose initial value is not a constant, or \c nullptr until a global variable with an initial value is built.
+             */
+            llvm::Function *globalInitFunction = nullptr;
+            /*!
+             \brief The block of \c globalInitFunction where the next initial value is built.
+             */
+            llvm::BasicBlock *globalInitBlock = nullptr;
+            
+            /*!
+             \brief The reachability analysis for the whole program, or \c nullptr if every declaration should be built.
+             */
+            const reachability::ReachabilityAnalysis *reachableDecls = nullptr;
+            /*!
+             \brief The side effects inferred for the functions of the program, or \c nullptr if functions should get no attributes about their side effects.
+             */
+            const purity::PurityAnalysis *purity = nullptr;
+            /*!
+             \brief The accesses proven to be in bounds and the checks hoisted out of loops, or \c nullptr if every access should be checked.
+             */
+            const bounds::BoundsCheckAnalysis *boundsCheckAnalysis = nullptr;
+            /*!
+             \brief Whether the accesses to arrays and slices should be checked at run-time.
+             */
+            bool boundsChecks = true;
+            
+            /*!
+             \brief Whether the loads and stores should be tagged with type-based alias analysis metadata.
+             */
+            bool strictAliasing = true;
+            /*!
+             \brief The TBAA type nodes built for the types of the module.
+             */
+            std::map<ast::Type *, llvm::MDNode *> tbaaTypeNodes;
+            /*!
+             \brief The root of the TBAA type nodes and the node of the character types, which may alias any other type. These are \c nullptr until the first tag is built.
+             */
+            llvm::MDNode *tbaaRoot = nullptr, *tbaaCharNode = nullptr;
+            
+            /*!
+             \brief Whether the fields of the classes not declared \c pinned should be reordered to minimize padding.
+             */
+            bool reorderClassFields = false;
+            /*!
+             \brief Whether the memory layout of the classes declared in the unit should be printed.
+             */
+            bool dumpClassLayouts = false;
+            
         public:
             ModuleBuilder(modules::ModuleWrapper &moduleWrapper, target::TargetInfo &targetInfo);
             virtual ~ModuleBuilder() {  }
@@ -152,11 +312,62 @@ namespace hpc {
                 return *builder;
             }
             
+            /*!
+             \brief Makes the builder skip the top-level functions, classes and global variables not reachable according to the given analysis.
+             */
+            inline void setReachableDecls(const reachability::ReachabilityAnalysis *analysis) {
+                reachableDecls = analysis;
+            }
+            
+            /*!
+             \brief Makes the builder add the LLVM attributes describing the side effects of the functions, according to the given analysis.
+             */
+            inline void setPurityAnalysis(const purity::PurityAnalysis *analysis) {
+                purity = analysis;
+            }
+            
+            /*!
+             \brief Sets whether the accesses to arrays and slices are checked, skipping the checks found redundant by the given analysis.
+             */
+            inline void setBoundsChecks(bool enabled, const bounds::BoundsCheckAnalysis *analysis) {
+                boundsChecks = enabled;
+                boundsCheckAnalysis = analysis;
+            }
+            
+            /*!
+             \brief Sets whether the memory accesses are tagged with TBAA metadata, allowing LLVM to assume that accesses to different types never alias.
+             */
+            inline void setStrictAliasing(bool enabled) {
+                strictAliasing = enabled;
+            }
+            
+            /*!
+             \brief Sets whether class fields should be reordered to minimize padding, and whether class layouts should be printed.
+             \note Both require the target machine to be created, as the layouts depend on the target data layout.
+             */
+            inline void setClassLayoutOptions(bool reorderFields, bool dumpLayouts) {
+                reorderClassFields = reorderFields;
+                dumpClassLayouts = dumpLayouts;
+            }
+            
+            /*!
+             \brief Sets whether the scalar parameters and local variables are built directly in SSA form, so that the code is fast without running \c mem2reg.
+             */
+            inline void setDirectSSA(bool enabled) {
+                directSSA = enabled;
+            }
+            
             inline void buildUnit(ast::CompilationUnit *unit) {
                 assert(unit && "Passing nullptr as unit.");
                 visitUnit(*unit);
             }
             
+            /*!
+             \brief Builds the address of the element of an array or a slice accessed by the given expression, checking its index if needed.
+             \param field The field of the element to address, which is required for arrays stored by columns.
+             */
+            llvm::Value *getElementReference(ast::SubscriptExpr *subscript, ast::FieldDecl *field = nullptr);
+            
         private:
             llvm::Value *build(ast::Component *component) {
                 if (!component) return nullptr;
@@ -169,7 +380,14 @@ namespace hpc {
                 if (var.getType()->isBooleanType()) {
                     val = builder->CreateZExt(val, table.getIRType(var.getType()));
                 }
-                return builder->CreateStore(val, table.getOrCreateReference(var));
+                
+                if (isSSAVar(&var)) {
+                    writeVariable(&var, builder->GetInsertBlock(), val);
+                    return nullptr;
+                }
+                llvm::StoreInst *store = builder->CreateAlignedStore(val, table.getOrCreateReference(var), getAlignment(var.getType()));
+                addAccessTag(store, var.getType());
+                return store;
             }
             
             inline llvm::StoreInst *assign(ast::Var *var, llvm::Value *val) {
@@ -180,6 +398,216 @@ namespace hpc {
                 return table.getIRType(type->getCanonicalType());
             }
             
+            /*!
+             \brief Returns whether the given top-level declaration should be built into the module.
+             */
+            bool shouldBuild(ast::Decl *decl) const;
+            
+            /*!
+             \brief Returns the fields of the given class in the order they are laid out in memory.
+             */
+            std::vector<ast::FieldDecl *> getFieldsLayout(ast::ClassDecl *classDecl);
+            /*!
+             \brief Returns the types of the elements of the IR structure laying out the given fields of a class in this order, with the padding between them and at the end.
+             \param slots Receives the index of the element of each field.
+             */
+            std::vector<llvm::Type *> getClassElementTypes(ast::ClassDecl *classDecl, const std::vector<ast::FieldDecl *> &fields, std::vector<unsigned> &slots);
+            /*!
+             \brief Prints the memory layout of the given class in declaration order and as built, with the size, padding and offset of each field.
+             */
+            void dumpClassLayout(ast::ClassDecl *classDecl);
+            /*!
+             \brief Returns the number of bytes the size of the given class must be a multiple of, or 0 if no tail padding was requested.
+             */
+            unsigned getClassPadding(ast::ClassDecl *classDecl);
+            /*!
+             \brief Returns the alignment requested for the objects of the given type, or 0 if they have the ABI alignment of their IR type.
+             */
+            unsigned getRequestedAlignment(ast::Type *type);
+            /*!
+             \brief Returns the alignment of the memory referenced by the given expression.
+             \note Fields of packed classes may be misaligned, so they are accessed with an alignment of 1.
+             */
+            unsigned getAccessAlignment(ast::Expr *reference);
+            /*!
+             \brief Returns the TBAA type node for the given type, or \c nullptr for arrays and slices, whose elements are accessed with scalar tags.
+             \note Classes get a struct-path node listing the offset and type node of their fields, so that accesses to different fields of the same class never alias.
+             */
+            llvm::MDNode *getTBAATypeNode(ast::Type *type);
+            /*!
+             \brief Returns the TBAA tag for an access to the memory referenced by the given expression, or \c nullptr if it is not a scalar or a vector.
+             */
+            llvm::MDNode *getTBAAAccessTag(ast::Expr *reference);
+            /*!
+             \brief Tags the given load or store with the TBAA metadata and the alias scopes for an access to the memory referenced by the given expression.
+             */
+            void addAccessTag(llvm::Instruction *access, ast::Expr *reference);
+            /*!
+             \brief Tags the given load or store with the TBAA metadata for an access to a value of the given type, outside of any class.
+             */
+            void addAccessTag(llvm::Instruction *access, ast::Type *type);
+            /*!
+             \brief Creates an alias scope for each parameter and local variable of the given function that is an exclusive slice.
+             */
+            void createAliasScopes(ast::FunctionDecl *function);
+            /*!
+             \brief Marks the given load or store as not aliasing the elements of the other exclusive slices, if it accesses an element of an exclusive slice.
+             */
+            void addAliasScopes(llvm::Instruction *access, ast::Expr *reference);
+            /*!
+             \brief Converts \c value from the \c original type to the \c destination type.
+             \note Vectors are converted lane by lane, so both types must be scalars or vectors with the same number of lanes.
+             */
+            llvm::Value *createConversion(llvm::Value *value, ast::Type *original, ast::Type *destination);
+            /*!
+             \brief Returns the address of the value of the given expression, storing the value to a temporary if it is not in memory.
+             */
+            llvm::Value *getOrSpillReference(ast::Expr *expression);
+            /*!
+             \brief Starts building the given function in SSA form, selecting its scalar parameters and local variables, which get no stack slot.
+             \note The block being built must be the entry block of the function.
+             */
+            void beginSSA(ast::FunctionDecl *function);
+            /*!
+             \brief Seals the blocks left unsealed in the given function, and forgets the values of its variables.
+             */
+            void endSSA(llvm::Function *irfunc);
+            /*!
+             \brief Returns whether the given variable is built in SSA form, so that it has no address.
+             */
+            inline bool isSSAVar(ast::Var *var) const {
+                return ssaDefinitions.count(var);
+            }
+            /*!
+             \brief Sets the value of the given variable at the end of \c block.
+             */
+            void writeVariable(ast::Var *var, llvm::BasicBlock *block, llvm::Value *value);
+            /*!
+             \brief Returns the value of the given variable at the end of \c block, creating the phis merging its values from the predecessors if needed.
+             \see Braun et al., "Simple and Efficient Construction of Static Single Assignment Form", for the algorithm.
+             */
+            llvm::Value *readVariable(ast::Var *var, llvm::BasicBlock *block);
+            /*!
+             \brief Creates a phi without operands at the beginning of \c block.
+             */
+            llvm::PHINode *createPhi(llvm::Type *type, llvm::BasicBlock *block);
+            /*!
+             \brief Adds to \c phi the value of \c var from each predecessor of its block, and returns the value it is replaced with if it turns out trivial.
+             */
+            llvm::Value *addPhiOperands(ast::Var *var, llvm::PHINode *phi);
+            /*!
+             \brief Replaces and removes \c phi if it merges a single value other than itself, and returns that value, or \c phi if it is needed.
+             */
+            llvm::Value *tryRemoveTrivialPhi(llvm::PHINode *phi);
+            /*!
+             \brief Marks all the predecessors of \c block as known, completing the phis created in it. This does nothing unless building in SSA form.
+             */
+            void sealBlock(llvm::BasicBlock *block);
+            /*!
+             \brief Allocates a temporary of the given type in the entry block of the function being built, so that a loop does not grow the stack.
+             */
+            llvm::AllocaInst *createTemporary(llvm::Type *type, unsigned alignment);
+            /*!
+             \brief Returns how the return value and the parameters of the given function are passed on the target.
+             */
+            const target::FunctionABIInfo &getFunctionABI(ast::FunctionDecl *function);
+            /*!
+             \brief Reinterprets the memory representation of \c value as the \c destination type, through a temporary.
+             \note This converts classes to and from the types of the registers they are passed in.
+             */
+            llvm::Value *createCoercion(llvm::Value *value, llvm::Type *destination);
+            /*!
+             \brief Builds the IR arguments passed to the function called by \c functionCall, lowered according to the ABI.
+             \param returnSlot The memory receiving the return value, passed first when it is returned indirectly, or \c nullptr.
+             \param copyObjects Whether the objects passed in memory are always copied to temporaries, which live until the function returns.
+             */
+            std::vector<llvm::Value *> buildCallArgs(ast::FunctionCall *functionCall, llvm::Value *returnSlot, bool copyObjects = false);
+            /*!
+             \brief Returns the value returned by \c call to \c callee, converted back from its lowered representation.
+             */
+            llvm::Value *createCallResult(llvm::CallInst *call, ast::FunctionDecl *callee, llvm::Value *returnSlot);
+            /*!
+             \brief Loads the object of the given type stored at \c reference as the \c coercedType it is passed as, reading its memory directly when the coerced type does not go past its end.
+             */
+            llvm::Value *createCoercedLoad(llvm::Value *reference, ast::Type *type, unsigned alignment, llvm::Type *coercedType);
+            /*!
+             \brief Builds the call of \c functionCall, passing \c returnSlot as the memory receiving an object returned indirectly.
+             */
+            llvm::CallInst *createCall(ast::FunctionCall *functionCall, llvm::Value *returnSlot);
+            /*!
+             \brief Returns whether the values of the given type are objects of a class, which are copied in memory rather than through registers.
+             */
+            bool isObjectType(ast::Type *type);
+            /*!
+             \brief Copies the object built by \c source to the memory at \c destination, with \c llvm.memcpy when it is already in memory.
+             \param isFresh Whether \c destination cannot be read while \c source is evaluated, so that a function returning the object in memory may construct it there directly.
+             \note When \c destination is not fresh, the object returned in memory goes through a temporary whose lifetime ends after the copy, so that LLVM may still forward the call to \c destination.
+             */
+            llvm::Value *createObjectCopy(ast::Expr *source, llvm::Value *destination, unsigned alignment, bool isFresh);
+            /*!
+             \brief Returns the value stored at \c address if it is known at compile time, as in the constant global variables with a constant initial value, or \c nullptr otherwise.
+             */
+            llvm::Constant *getConstantLoad(llvm::Value *address);
+            /*!
+             \brief Terminates the global initialization function and registers it as a constructor of the module, or removes it if no global variable needs it.
+             */
+            void finalizeGlobalInit();
+            /*!
+             \brief Converts the given integer value of type \c type to a 64 bits index.
+             */
+            llvm::Value *createIndex(llvm::Value *value, ast::Type *type);
+            /*!
+             \brief Marks the beginning or the end of the lifetime of the given local variable, with \c llvm.lifetime.start or \c llvm.lifetime.end.
+             */
+            void createLifetimeMarker(ast::Var *var, bool start);
+            /*!
+             \brief Ends the lifetime of the variables declared in the blocks being built, from the innermost to the block number \c depth.
+             \note This does not remove the blocks from \c scopes, as it is used by the statements leaving them early.
+             */
+            void endScopes(size_t depth);
+            /*!
+             \brief Returns the number of blocks being built outside the body of the given loop or switch statement, so that leaving it ends the lifetime of the blocks after them.
+             */
+            size_t getLoopScopeDepth(ast::Stmt *loop) const;
+            /*!
+             \brief Starts the lifetime of the variables declared in the given block and pushes it into \c scopes.
+             */
+            void beginScope(ast::CompoundStmt *block);
+            /*!
+             \brief Ends the lifetime of the variables declared in the innermost block, unless it has already been left, and pops it from \c scopes.
+             */
+            void endScope();
+            /*!
+             \brief Branches to the trap block of the function being built unless \c inBounds is true.
+             */
+            void createBoundsCheck(llvm::Value *inBounds);
+            /*!
+             \brief Builds the 64 bits index of the given access, checked against \c length if needed.
+             */
+            llvm::Value *createCheckedIndex(ast::SubscriptExpr *subscript, llvm::Value *length);
+            /*!
+             \brief Builds the 64 bits index of the lane of \c vector accessed by the given subscript, checked against the number of lanes if needed.
+             \note Unless bounds checks are enabled, an index that is not constant wraps around the lanes.
+             */
+            llvm::Value *createLaneIndex(ast::SubscriptExpr *subscript, llvm::Value *vector);
+            /*!
+             \brief Returns the address of the given field of the element at \c index, in an array stored by columns.
+             */
+            llvm::Value *getColumnReference(ast::ArrayType *arrayType, llvm::Value *arrayRef, ast::FieldDecl *field, llvm::Value *index);
+            /*!
+             \brief Loads the element of an array stored by columns accessed by the given expression, reading each field from its column.
+             */
+            llvm::Value *loadColumns(ast::SubscriptExpr *subscript);
+            /*!
+             \brief Stores \c element to the element of an array stored by columns accessed by the given expression, writing each field to its column.
+             */
+            llvm::StoreInst *storeColumns(ast::SubscriptExpr *subscript, llvm::Value *element);
+            /*!
+             \brief Attaches the directives of the given loop to the branches back to \c header, as \c llvm.loop metadata.
+             \note The blocks of the loop are the ones between \c header and \c exit in the function, so the loop must be completely built.
+             */
+            void addLoopDirectives(ast::SimpleIterStmt *statement, llvm::BasicBlock *header, llvm::BasicBlock *exit);
+            
             
         public:
             
@@ -187,11 +615,23 @@ namespace hpc {
                 return targetInfo;
             }
             
+            inline llvm::DataLayout &getDataLayout() {
+                return dataLayout;
+            }
+            
+            /*!
+             \brief Returns the alignment of the objects of the given type, which is the requested one or the ABI alignment of its IR type in the target data layout.
+             */
+            unsigned getAlignment(ast::Type *type);
+            
             void visitUnit(ast::CompilationUnit &unit);
 
             void visitBuiltinType(ast::BuiltinType *type);
             void visitPointerType(ast::PointerType *type);
             void visitClassType(ast::ClassType *type);
+            void visitVectorType(ast::VectorType *type);
+            void visitArrayType(ast::ArrayType *type);
+            void visitSliceType(ast::SliceType *type);
             void visitQualifiedType(ast::QualifiedType *type);
             
             void visitNameSpaceDecl(ast::NameSpaceDecl *nameSpace);
@@ -210,7 +650,8 @@ namespace hpc {
             void visitContinueStmt(ast::ContinueStmt *statement);
             
             void visitIfStmt(ast::IfStmt *statement);
-            //void visitSwitchStmt(ast::SwitchStmt *statement) {  }
+            void visitSwitchStmt(ast::SwitchStmt *statement);
+            void visitCaseStmt(ast::CaseStmt *statement);
             
             void visitPreWhileStmt(ast::PreWhileStmt *statement);
             void visitPreUntilStmt(ast::PreUntilStmt *statement);
@@ -235,6 +676,9 @@ namespace hpc {
             void visitVarRef(ast::VarRef *varRef);
             void visitFunctionCall(ast::FunctionCall *functionCall);
             void visitFieldRef(ast::FieldRef *fieldRef);
+            void visitSubscriptExpr(ast::SubscriptExpr *subscript);
+            void visitLengthExpr(ast::LengthExpr *length);
+            void visitShuffleExpr(ast::ShuffleExpr *shuffle);
             
             void visitCharLiteral(ast::CharLiteral *literal);
             void visitIntegerLiteral(ast::IntegerLiteral *literal);
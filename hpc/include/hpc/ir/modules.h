@@ -11,6 +11,7 @@
 #define __human_plus_compiler_ir_modules
 
 #include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 
 #include <string>
@@ -26,8 +27,13 @@ namespace hpc {
         
         /*!
          \brief An object that handles the creation of an LLVM module.
+         \note Each module has its own LLVM context, so that different modules can be built on different threads.
          */
         class ModuleWrapper {
+            /*!
+             \brief The LLVM context owning the types and constants of the module.
+             */
+            llvm::LLVMContext context;
             /*!
              \brief The LLVM IR module this object is handling.
              */
@@ -42,7 +48,6 @@ namespace hpc {
             /*!
              \brief Initializes the module wrapper.
              \param modulename The name that the new module will have
-             \param context The LLVM context to give to the new module
              */
             ModuleWrapper(std::string modulename);
             virtual ~ModuleWrapper() {  }
@@ -52,6 +57,13 @@ namespace hpc {
              */
             llvm::Module &getModule();
             
+            /*!
+             \brief Returns the LLVM context of the wrapped module.
+             */
+            inline llvm::LLVMContext &getContext() {
+                return context;
+            }
+            
             /*!
              \brief Adds the first information to the wrapped LLVM IR module.
              */
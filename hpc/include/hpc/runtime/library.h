@@ -0,0 +1,75 @@
+// => hpc/runtime/library.h
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#ifndef __human_plus_compiler_runtime_library
+#define __human_plus_compiler_runtime_library
+
+#include <llvm/IR/Function.h>
+#include <llvm/Pass.h>
+
+namespace hpc {
+    namespace runtime {
+        
+        /*!
+         \brief The functions of the humanlogic runtime library whose semantics are known to the compiler.
+         */
+        typedef enum {
+            ReadChar,
+            ReadInteger,
+            WriteChar,
+            WriteInteger,
+            WriteString,
+            
+            NumRuntimeFunctions
+        } RuntimeFunction;
+        
+        /*!
+         \brief The semantics of a runtime function.
+         */
+        struct RuntimeFunctionInfo {
+            /*!
+             \brief The unmangled name of the function, as declared by \c nostalgic functions.
+             */
+            const char *name;
+            /*!
+             \brief The number of arguments of the function.
+             */
+            unsigned numArgs;
+            /*!
+             \brief The index of the argument pointing to a null-terminated string which the function reads and does not keep, or \c -1 if there is none.
+             */
+            int stringArg;
+        };
+        
+        /*!
+         \brief Returns the semantics of the given runtime function.
+         */
+        const RuntimeFunctionInfo &getRuntimeFunctionInfo(RuntimeFunction runtimeFunction);
+        
+        /*!
+         \brief Returns whether \c function is a declaration of a runtime function with the expected prototype, setting \c runtimeFunction to it.
+         */
+        bool getRuntimeFunction(const llvm::Function &function, RuntimeFunction &runtimeFunction);
+        
+        /*!
+         \brief Adds to the declaration of a runtime function the attributes describing its semantics, and returns whether \c function is a runtime function.
+         \note The runtime functions only access the state of the standard streams, which is never visible to the program, and the strings given to them. They never unwind.
+         */
+        bool addRuntimeAttributes(llvm::Function &function);
+        
+        /*!
+         \brief Creates a pass which simplifies the calls to the runtime functions whose arguments are known.
+         \note Consecutive calls to \c writeString with constant strings are merged into a single call, and a string of a single character is written with \c writeChar.
+         */
+        llvm::FunctionPass *createRuntimeCallsPass();
+        
+    }
+}
+
+#endif
@@ -13,12 +13,52 @@
 #include <hpc/target/mangle.h>
 #include <hpc/utils/opts.h>
 
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/Type.h>
+
 #include <string>
+#include <vector>
 
 namespace hpc {
     
     namespace target {
         
+        /*!
+         \brief Describes how a parameter or a return value is passed between functions by the calling convention of the target.
+         */
+        struct ABIArgInfo {
+            typedef enum {
+                /*!
+                 \brief The value is passed with its own IR type, leaving its lowering to LLVM.
+                 */
+                Direct,
+                /*!
+                 \brief The value is reinterpreted as \c coercedType, whose elements are passed in registers.
+                 */
+                Coerced,
+                /*!
+                 \brief The value is passed in memory: a parameter is copied by the caller and passed by address (\c byval), a return value is stored by the callee to memory given by the caller (\c sret).
+                 */
+                Indirect
+            } Kind;
+            
+            Kind kind;
+            /*!
+             \brief The type a coerced value is reinterpreted as, or \c nullptr for the other kinds.
+             */
+            llvm::Type *coercedType;
+            
+            ABIArgInfo(Kind kind = Direct, llvm::Type *coercedType = nullptr) : kind(kind), coercedType(coercedType) {  }
+        };
+        
+        /*!
+         \brief Describes how the return value and the parameters of a function are passed.
+         */
+        struct FunctionABIInfo {
+            ABIArgInfo returnInfo;
+            std::vector<ABIArgInfo> argInfos;
+        };
+        
         /*!
          \brief Class which defines an abstraction layer for Application Binary Interfaces used by the Human Plus Compiler.
          */
@@ -118,6 +158,12 @@ namespace hpc {
              */
             bool isMicrosoftABI() const;
             
+            /*!
+             \brief Classifies the return value and the parameters of a function with the given IR types, according to the C calling convention of the target.
+             \note The default implementation passes every value directly, leaving its lowering to LLVM.
+             */
+            virtual FunctionABIInfo classifyFunction(llvm::Type *returnType, const std::vector<llvm::Type *> &paramTypes, const llvm::DataLayout &dataLayout) const;
+            
             
             inline friend bool operator==(const TargetABI &left, const TargetABI &right) {
                 return left.getKind() == right.getKind();
@@ -134,6 +180,43 @@ namespace hpc {
             
         };
         
+        /*!
+         \brief The System V ABI for x86-64, used by Linux, macOS and the BSDs.
+         \see https://github.com/hjl-tools/x86-psABI for a complete documentation of the ABI.
+         */
+        class X8664SysVABI : public TargetABI {
+            
+            /*!
+             \brief The classes given to each eightbyte of a value, which select the registers it is passed in.
+             */
+            typedef enum {
+                NoClass,
+                Integer,
+                SSE,
+                SSEUp,
+                Memory
+            } ArgClass;
+            
+            /*!
+             \brief Merges into \c classes the classes of the eightbytes covered by a value of the given type at \c offset, in an aggregate of up to two eightbytes.
+             */
+            void classifyEightbytes(llvm::Type *type, uint64_t offset, ArgClass classes[2], const llvm::DataLayout &dataLayout) const;
+            /*!
+             \brief Returns the type of the register holding the eightbyte at \c offset of a value of the given type, whose class is \c argClass.
+             */
+            llvm::Type *getEightbyteType(llvm::Type *type, uint64_t offset, ArgClass argClass, const llvm::DataLayout &dataLayout) const;
+            /*!
+             \brief Classifies a parameter or a return value of the given type, taking the registers it uses from the free ones.
+             */
+            ABIArgInfo classify(llvm::Type *type, bool isReturn, unsigned &freeIntRegs, unsigned &freeSSERegs, const llvm::DataLayout &dataLayout) const;
+            
+        public:
+            X8664SysVABI(opts::TargetOptions &opts) : TargetABI(opts, CXXGenericItanium) {  }
+            
+            virtual FunctionABIInfo classifyFunction(llvm::Type *returnType, const std::vector<llvm::Type *> &paramTypes, const llvm::DataLayout &dataLayout) const;
+            
+        };
+        
     }
 }
 
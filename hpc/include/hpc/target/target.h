@@ -27,6 +27,11 @@
 
 namespace hpc {
     
+    namespace ast {
+        class Type;
+        class ClassDecl;
+    }
+    
     namespace target {
         
         class TargetInfo {
@@ -123,7 +128,7 @@ namespace hpc {
             llvm::TargetLibraryInfoImpl *createTLII();
             
             /*!
-             \brief Creates the target machine.
+             \brief Creates the target machine, unless it has already been created.
              \param diags If LLVM could not create target, an error will be reported here. 
              */
             bool createTargetMachine(opts::BackendOptions &backendOptions, diag::DiagEngine &diags);
@@ -138,9 +143,25 @@ namespace hpc {
             }
             /*!
              \brief Returns the data layout used by this target.
-             \note \c createMachineTarget() must be called first, or the function will assert.
+             \note \c createMachineTarget() must be called first, or the function will assert. The data layout is created by the first call, which must not be concurrent with any other.
              */
             llvm::DataLayout &getDataLayout();
+            /*!
+             \brief Returns the size in bytes of a cache line on the target architecture.
+             \note LLVM only exposes the cache line size through the TargetTransformInfo of a function, so the size is looked up by architecture.
+             */
+            unsigned getCacheLineSize() const;
+            
+            /*!
+             \brief Returns the alignment in bytes requested for the given class on the target, or 0 if its natural alignment should be used.
+             \note The alignment requested for the classes of the fields is included, unless the class is packed.
+             */
+            unsigned getClassAlignment(ast::ClassDecl *classDecl);
+            /*!
+             \brief Returns the alignment requested for the objects of the given type, or 0 if they have their natural alignment.
+             \note The natural alignment is the ABI alignment of the IR type, which the code generator raises to the requested one.
+             */
+            unsigned getRequestedAlignment(ast::Type *type);
             
             /*!
              \brief Adds the target attributes to the functions of the given module.
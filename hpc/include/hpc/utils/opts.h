@@ -71,6 +71,34 @@ namespace hpc {
              \brief A boolean indicating whether the user has requested a verbosed output (-v).
              */
             bool verbose = false;
+            /*!
+             \brief A boolean indicating whether the input files make up the whole program (-fwhole-program), so that declarations unreachable from \c main can be skipped.
+             */
+            bool wholeProgram = false;
+            /*!
+             \brief A boolean indicating whether the fields of classes not declared \c pinned should be reordered to minimize padding (-freorder-class-fields).
+             */
+            bool reorderClassFields = false;
+            /*!
+             \brief A boolean indicating whether the memory layout of every class should be printed (-fdump-class-layouts).
+             */
+            bool dumpClassLayouts = false;
+            /*!
+             \brief A boolean indicating whether the accesses to arrays and slices should be checked at run-time, unless disabled with -fno-bounds-checks.
+             */
+            bool boundsChecks = true;
+            /*!
+             \brief A boolean indicating whether memory accesses should be tagged with their type for alias analysis, unless disabled with -fno-strict-aliasing.
+             */
+            bool strictAliasing = true;
+            /*!
+             \brief A boolean indicating whether the scalar variables should be built directly in SSA form rather than in stack slots (-fdirect-ssa).
+             */
+            bool directSSA = false;
+            /*!
+             \brief The number of threads building the LLVM modules of the source files (-fcodegen-threads=), or 0 to use one thread per hardware thread.
+             */
+            unsigned codegenThreads = 0;
             
             
             ~FrontendOptions();
@@ -84,6 +112,10 @@ namespace hpc {
              \brief The name the compiler was called by the command line with.
              */
             std::string compilerName;
+            /*!
+             \brief A boolean indicating whether warnings about code patterns that are known to be slow should be reported (-Wperformance).
+             */
+            bool performanceWarnings = false;
         };
         
         /*!
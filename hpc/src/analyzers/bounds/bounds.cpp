@@ -0,0 +1,391 @@
+// => src/analyzers/bounds/bounds.cpp
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#include <hpc/analyzers/bounds/bounds.h>
+#include <hpc/ast/unit.h>
+#include <hpc/ast/decls/namespace.h>
+#include <hpc/ast/decls/variable.h>
+#include <hpc/ast/decls/function.h>
+#include <hpc/ast/types/arraytype.h>
+#include <hpc/ast/stmt/statement.h>
+#include <hpc/ast/stmt/ifelse.h>
+#include <hpc/ast/stmt/switchselect.h>
+#include <hpc/ast/stmt/whileuntil.h>
+#include <hpc/ast/stmt/for.h>
+#include <hpc/ast/exprs/binary.h>
+#include <hpc/ast/exprs/unary.h>
+#include <hpc/ast/exprs/castings.h>
+#include <hpc/ast/exprs/constant.h>
+#include <hpc/ast/exprs/reference.h>
+#include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/shuffle.h>
+
+#include <algorithm>
+
+using namespace hpc;
+
+/*!
+ \brief Returns \c expression without the casts and the evaluation wrappers around it.
+ */
+static ast::Expr *stripCasts(ast::Expr *expression) {
+    while (true) {
+        if (ast::ImplicitCastExpr *cast = llvm::dyn_cast<ast::ImplicitCastExpr>(expression)) expression = cast->getExpression();
+        else if (ast::EvalExpr *eval = llvm::dyn_cast<ast::EvalExpr>(expression)) expression = eval->getExpression();
+        else return expression;
+    }
+}
+
+/*!
+ \brief Returns whether \c expression is an integer literal, storing its value in \c value.
+ */
+static bool getIntegerConstant(ast::Expr *expression, int64_t &value) {
+    expression = stripCasts(expression);
+
+    if (ast::IntegerLiteral *literal = llvm::dyn_cast<ast::IntegerLiteral>(expression)) value = literal->getValue();
+    else if (ast::LongLiteral *literal = llvm::dyn_cast<ast::LongLiteral>(expression)) value = literal->getValue();
+    else if (ast::UIntegerLiteral *literal = llvm::dyn_cast<ast::UIntegerLiteral>(expression)) value = literal->getValue();
+    else if (ast::ULongLiteral *literal = llvm::dyn_cast<ast::ULongLiteral>(expression)) {
+        if (literal->getValue() > (uint64_t)INT64_MAX) return false;
+        value = literal->getValue();
+    } else return false;
+
+    return true;
+}
+
+/*!
+ \brief Returns the variable referenced by \c expression, or \c nullptr if it is not a plain reference to a variable.
+ */
+static ast::Var *getReferencedVar(ast::Expr *expression) {
+    if (ast::VarRef *varRef = llvm::dyn_cast<ast::VarRef>(stripCasts(expression))) return varRef->getVar();
+    return nullptr;
+}
+
+/*!
+ \brief Returns the variable written by an assignment to \c expression, if known.
+ */
+static ast::Var *getAssignedVar(ast::Expr *expression) {
+    if (ast::VarRef *varRef = llvm::dyn_cast<ast::VarRef>(expression)) return varRef->getVar();
+    if (ast::FieldRef *fieldRef = llvm::dyn_cast<ast::FieldRef>(expression)) return getAssignedVar(fieldRef->getEntity());
+    // elements of slices live outside the variable holding the slice.
+    if (ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(expression))
+        return subscript->getEntity()->evalType()->isSliceType() ? nullptr : getAssignedVar(subscript->getEntity());
+    return nullptr;
+}
+
+/*!
+ \brief Returns whether \c statement is <tt>var = var + 1</tt>.
+ */
+static bool isIncrementOf(ast::Stmt *statement, ast::Var *var) {
+    ast::AssignmentExpr *assignment = llvm::dyn_cast<ast::AssignmentExpr>(statement);
+    if (!assignment || assignment->getOperator() != lexer::TokenOperatorAssign || getReferencedVar(assignment->getLHS()) != var) return false;
+
+    ast::ArithmeticExpr *sum = llvm::dyn_cast<ast::ArithmeticExpr>(stripCasts(assignment->getRHS()));
+    if (!sum || sum->getOperator() != lexer::TokenOperatorPlus) return false;
+
+    int64_t step;
+    if (getReferencedVar(sum->getLHS()) == var) return getIntegerConstant(sum->getRHS(), step) && step == 1;
+    if (getReferencedVar(sum->getRHS()) == var) return getIntegerConstant(sum->getLHS(), step) && step == 1;
+    return false;
+}
+
+
+bool bounds::BoundsCheckAnalysis::getInductionRange(ast::ForStmt *statement, InductionRange &range, ast::Stmt *&increment) {
+    if (statement->getInitStatements().size() != 1 || statement->getEndStatements().size() != 1) return false;
+
+    ast::Stmt *init = statement->getInitStatements().front();
+    ast::Var *var = nullptr;
+    ast::Expr *initialValue = nullptr;
+
+    if (ast::VarDeclStmt *declaration = llvm::dyn_cast<ast::VarDeclStmt>(init)) {
+        if (declaration->getDeclaredVariables().size() != 1) return false;
+        var = declaration->getDeclaredVariables().front();
+        initialValue = var->getInitialValue();
+    } else if (ast::AssignmentExpr *assignment = llvm::dyn_cast<ast::AssignmentExpr>(init)) {
+        if (assignment->getOperator() != lexer::TokenOperatorAssign) return false;
+        var = getReferencedVar(assignment->getLHS());
+        initialValue = assignment->getRHS();
+    }
+
+    // unsigned variables wrap around, so only signed ones are known to stay within the range.
+    if (!var || llvm::isa<ast::GlobalVar>(var) || !var->getType()->getCanonicalType()->isSignedIntegerType()) return false;
+    if (!initialValue || !getIntegerConstant(initialValue, range.lowerBound) || range.lowerBound < 0) return false;
+
+    ast::ComparisonExpr *condition = llvm::dyn_cast<ast::ComparisonExpr>(stripCasts(statement->getCondition()));
+    if (!condition || getReferencedVar(condition->getLHS()) != var) return false;
+
+    if (condition->getOperator() == lexer::TokenOperatorLower) range.inclusive = false;
+    else if (condition->getOperator() == lexer::TokenOperatorLowerEqual) range.inclusive = true;
+    else return false;
+
+    increment = statement->getEndStatements().front();
+    if (!isIncrementOf(increment, var)) return false;
+
+    range.var = var;
+    range.upperBound = condition->getRHS();
+    return true;
+}
+
+void bounds::BoundsCheckAnalysis::markVariant(ast::Var *var) {
+    if (!var) return;
+
+    for (LoopInfo &loop : loops) loop.variants.insert(var);
+}
+
+bool bounds::BoundsCheckAnalysis::isLoopInvariant(ast::Expr *expression, const LoopInfo &loop) const {
+    if (llvm::isa<ast::Constant>(expression)) return true;
+
+    if (ast::VarRef *varRef = llvm::dyn_cast<ast::VarRef>(expression)) {
+        ast::Var *var = varRef->getVar();
+        // global variables may be changed by any call in the loop.
+        return var && !llvm::isa<ast::GlobalVar>(var) && !loop.variants.count(var);
+    }
+
+    if (ast::ImplicitCastExpr *cast = llvm::dyn_cast<ast::ImplicitCastExpr>(expression))
+        return isLoopInvariant(cast->getExpression(), loop);
+    if (ast::EvalExpr *eval = llvm::dyn_cast<ast::EvalExpr>(expression))
+        return isLoopInvariant(eval->getExpression(), loop);
+    if (ast::FieldRef *fieldRef = llvm::dyn_cast<ast::FieldRef>(expression))
+        return isLoopInvariant(fieldRef->getEntity(), loop);
+    if (ast::LengthExpr *length = llvm::dyn_cast<ast::LengthExpr>(expression))
+        return isLoopInvariant(length->getEntity(), loop);
+    if (ast::BinaryExpr *binary = llvm::dyn_cast<ast::BinaryExpr>(expression))
+        return !llvm::isa<ast::AssignmentExpr>(binary) && isLoopInvariant(binary->getLHS(), loop) && isLoopInvariant(binary->getRHS(), loop);
+    if (ast::UnaryExpr *unary = llvm::dyn_cast<ast::UnaryExpr>(expression))
+        return isLoopInvariant(unary->getOperand(), loop);
+
+    return false;
+}
+
+void bounds::BoundsCheckAnalysis::resolveCandidates(const LoopInfo &loop) {
+    if (loop.candidates.empty() || loop.variants.count(loop.range.var)) return;
+
+    const InductionRange &range = loop.range;
+    ast::Expr *upperBound = stripCasts(range.upperBound);
+    bool invariantBound = isLoopInvariant(range.upperBound, loop);
+
+    int64_t constantBound;
+    bool hasConstantBound = getIntegerConstant(upperBound, constantBound);
+    ast::LengthExpr *lengthBound = llvm::dyn_cast<ast::LengthExpr>(upperBound);
+
+    for (const Candidate &candidate : loop.candidates) {
+        ast::Expr *entity = candidate.subscript->getEntity();
+
+        if (ast::ArrayType *arrayTy = llvm::dyn_cast<ast::ArrayType>(entity->evalType()->getCanonicalType())) {
+            uint64_t length = arrayTy->getLength();
+
+            // the last index reached is known at compile time.
+            if (hasConstantBound && constantBound >= 0 &&
+                (range.inclusive ? (uint64_t)constantBound < length : (uint64_t)constantBound <= length)) {
+                uncheckedAccesses.insert(candidate.subscript);
+                continue;
+            }
+
+            if (candidate.unconditional && !loop.exitsEarly && !loop.hasSideEffects && invariantBound) {
+                std::vector<HoistedCheck> &checks = hoistedChecks[loop.loop];
+                if (std::find_if(checks.begin(), checks.end(), [&](const HoistedCheck &check) {
+                    return !check.slice && check.arrayLength == length;
+                }) == checks.end()) checks.push_back(HoistedCheck{length, nullptr});
+
+                ranges[loop.loop] = range;
+                uncheckedAccesses.insert(candidate.subscript);
+            }
+            continue;
+        }
+
+        // slices are only handled through a local variable which is not changed by the loop.
+        ast::Var *slice = getReferencedVar(entity);
+        if (!slice || llvm::isa<ast::GlobalVar>(slice) || loop.variants.count(slice)) continue;
+
+        // i < length of s
+        if (lengthBound && !range.inclusive && getReferencedVar(lengthBound->getEntity()) == slice) {
+            uncheckedAccesses.insert(candidate.subscript);
+            continue;
+        }
+
+        if (candidate.unconditional && !loop.exitsEarly && !loop.hasSideEffects && invariantBound) {
+            std::vector<HoistedCheck> &checks = hoistedChecks[loop.loop];
+            if (std::find_if(checks.begin(), checks.end(), [&](const HoistedCheck &check) {
+                return check.slice == slice;
+            }) == checks.end()) checks.push_back(HoistedCheck{0, slice});
+
+            ranges[loop.loop] = range;
+            uncheckedAccesses.insert(candidate.subscript);
+        }
+    }
+}
+
+void bounds::BoundsCheckAnalysis::visitLoop(ast::SimpleIterStmt *statement, ast::ForStmt *forStmt) {
+    loops.push_back(LoopInfo());
+
+    ast::Stmt *increment = nullptr;
+    if (forStmt && getInductionRange(forStmt, loops.back().range, increment)) loops.back().loop = forStmt;
+
+    conditionalDepth++;
+    loops.back().depth = conditionalDepth;
+
+    scan(statement->getCondition());
+    if (forStmt) {
+        for (ast::Stmt *stmt : forStmt->getEndStatements()) {
+            if (stmt != increment) scan(stmt);
+        }
+    }
+    scan(statement->getBlock());
+
+    conditionalDepth--;
+
+    LoopInfo loop = loops.back();
+    loops.pop_back();
+
+    if (loop.loop) resolveCandidates(loop);
+}
+
+void bounds::BoundsCheckAnalysis::analyze(ast::AbstractSyntaxTree *ast) {
+    assert(ast && "No AST has been passed to the bounds check analysis.");
+
+    takeDecl(ast->getRootNameSpace());
+}
+
+const std::vector<bounds::HoistedCheck> &bounds::BoundsCheckAnalysis::getHoistedChecks(ast::ForStmt *statement) const {
+    static const std::vector<HoistedCheck> noChecks;
+
+    auto it = hoistedChecks.find(statement);
+    return it != hoistedChecks.end() ? it->second : noChecks;
+}
+
+const bounds::InductionRange *bounds::BoundsCheckAnalysis::getInductionRange(ast::ForStmt *statement) const {
+    auto it = ranges.find(statement);
+    return it != ranges.end() ? &it->second : nullptr;
+}
+
+void bounds::BoundsCheckAnalysis::visitNameSpaceDecl(ast::NameSpaceDecl *nameSpace) {
+    for (ast::Decl *decl : nameSpace->getDeclarations())
+        takeDecl(decl);
+}
+
+void bounds::BoundsCheckAnalysis::visitFunctionDecl(ast::FunctionDecl *function) {
+    scan(function->getStatementsBlock());
+}
+
+void bounds::BoundsCheckAnalysis::visitCompoundStmt(ast::CompoundStmt *statement) {
+    for (ast::Stmt *stmt : statement->statements()) scan(stmt);
+}
+
+void bounds::BoundsCheckAnalysis::visitVarDeclStmt(ast::VarDeclStmt *statement) {
+    for (ast::Var *var : statement->getDeclaredVariables()) {
+        markVariant(var); // a variable declared in a loop gets a new value on every iteration.
+        if (ast::Expr *initVal = var->getInitialValue()) scan(initVal);
+    }
+}
+
+void bounds::BoundsCheckAnalysis::visitReturnStmt(ast::ReturnStmt *statement) {
+    for (LoopInfo &loop : loops) loop.exitsEarly = true;
+    scan(statement->getReturnValue());
+}
+
+void bounds::BoundsCheckAnalysis::visitBreakStmt(ast::BreakStmt *statement) {
+    for (LoopInfo &loop : loops) loop.exitsEarly = true;
+}
+
+void bounds::BoundsCheckAnalysis::visitContinueStmt(ast::ContinueStmt *statement) {
+    for (LoopInfo &loop : loops) loop.exitsEarly = true;
+}
+
+void bounds::BoundsCheckAnalysis::visitIfStmt(ast::IfStmt *statement) {
+    scan(statement->getCondition());
+
+    conditionalDepth++;
+    scan(statement->getThenBlock());
+    scan(statement->getElseBlock());
+    conditionalDepth--;
+}
+
+void bounds::BoundsCheckAnalysis::visitSwitchStmt(ast::SwitchStmt *statement) {
+    scan(statement->getSelectionValue());
+
+    // each label may be skipped by the selection.
+    conditionalDepth++;
+    scan(statement->getBlock());
+    conditionalDepth--;
+}
+
+void bounds::BoundsCheckAnalysis::visitSimpleIterStmt(ast::SimpleIterStmt *statement) {
+    visitLoop(statement, nullptr);
+}
+
+void bounds::BoundsCheckAnalysis::visitForStmt(ast::ForStmt *statement) {
+    for (ast::Stmt *stmt : statement->getInitStatements()) scan(stmt);
+
+    visitLoop(statement, statement);
+}
+
+void bounds::BoundsCheckAnalysis::visitImplicitCastExpr(ast::ImplicitCastExpr *cast) {
+    scan(cast->getExpression());
+}
+
+void bounds::BoundsCheckAnalysis::visitEvalExpr(ast::EvalExpr *cast) {
+    scan(cast->getExpression());
+}
+
+void bounds::BoundsCheckAnalysis::visitBinaryExpr(ast::BinaryExpr *expression) {
+    scan(expression->getLHS());
+    scan(expression->getRHS());
+}
+
+void bounds::BoundsCheckAnalysis::visitAssignmentExpr(ast::AssignmentExpr *expression) {
+    ast::Var *var = getAssignedVar(expression->getLHS());
+    markVariant(var);
+
+    // writes to the elements of slices and to globals are visible outside the function, and would not happen if a hoisted check trapped first.
+    if (!var || llvm::isa<ast::GlobalVar>(var)) {
+        for (LoopInfo &loop : loops) loop.hasSideEffects = true;
+    }
+
+    visitBinaryExpr(expression);
+}
+
+void bounds::BoundsCheckAnalysis::visitUnaryExpr(ast::UnaryExpr *expression) {
+    scan(expression->getOperand());
+}
+
+void bounds::BoundsCheckAnalysis::visitFunctionCall(ast::FunctionCall *functionCall) {
+    // the callee may write output or end the program.
+    for (LoopInfo &loop : loops) loop.hasSideEffects = true;
+
+    for (ast::Expr *param : functionCall->getActualParams()) scan(param);
+}
+
+void bounds::BoundsCheckAnalysis::visitFieldRef(ast::FieldRef *fieldRef) {
+    scan(fieldRef->getEntity());
+}
+
+void bounds::BoundsCheckAnalysis::visitSubscriptExpr(ast::SubscriptExpr *subscript) {
+    scan(subscript->getEntity());
+    scan(subscript->getIndex());
+
+    if (subscript->getEntity()->evalType()->isVectorType()) return; // lanes are checked against the number of lanes, not a loop range.
+
+    ast::Var *index = getReferencedVar(subscript->getIndex());
+    if (!index) return;
+
+    // the innermost loop counting with this variable gives the range of the index.
+    for (auto it = loops.rbegin(); it != loops.rend(); ++it) {
+        if (it->loop && it->range.var == index) {
+            it->candidates.push_back(Candidate{subscript, conditionalDepth == it->depth});
+            break;
+        }
+    }
+}
+
+void bounds::BoundsCheckAnalysis::visitLengthExpr(ast::LengthExpr *length) {
+    scan(length->getEntity());
+}
+
+void bounds::BoundsCheckAnalysis::visitShuffleExpr(ast::ShuffleExpr *shuffle) {
+    for (ast::Expr *argument : shuffle->getArguments()) scan(argument);
+}
@@ -23,6 +23,10 @@ void lexer::LexerInstance::ignoreAndIfAny() {
     if (getCurrentToken() == TokenIdentifier && currentIdentifier == "and") getNextToken();
 }
 
+void lexer::LexerInstance::ignoreToIfAny() {
+    if (getCurrentToken() == TokenIdentifier && currentIdentifier == "to") getNextToken();
+}
+
 bool lexer::isDelimiter(char c) {
     return c == ';';
 }
@@ -55,12 +55,17 @@ lexer::token_ty lexer::LexerInstance::getNewToken(source::TokenRef *tkref) {
         .Case("alias",          TokenAlias)
         .Case("if",             TokenIf)
         .Case("then",           TokenThen)
+        .Case("likely",         TokenLikely)
+        .Case("unlikely",       TokenUnlikely)
         .Case("else",           TokenElse)
         .Case("do",             TokenDo)
         .Case("while",          TokenWhile)
         .Case("until",          TokenUntil)
         .Case("for",            TokenFor)
+        .Case("loop",           TokenLoop)
         .Case("switch",         TokenSwitch)
+        .Case("case",           TokenCase)
+        .Case("default",        TokenDefault)
         .Case("break",          TokenBreak)
         .Case("continue",       TokenContinue)
         .Case("return",         TokenReturnStatement)
@@ -69,6 +74,7 @@ lexer::token_ty lexer::LexerInstance::getNewToken(source::TokenRef *tkref) {
         .Case("and",            TokenOperatorLogicalAnd)
         .Case("or",             TokenOperatorLogicalOr)
         .Case("as",             TokenAs)
+        .Case("shuffle",        TokenShuffle)
         
         // literals
         .Case("true",           TokenTrue)
@@ -93,14 +99,23 @@ lexer::token_ty lexer::LexerInstance::getNewToken(source::TokenRef *tkref) {
         .Case("float",          TokenTypeFloat)
         .Case("single",         TokenTypeFloat)
         .Case("double",         TokenTypeDouble)
+        .Case("vector",         TokenVector)
+        .Case("array",          TokenArray)
+        .Case("slice",          TokenSlice)
         
         // type qualifiers and modifiers
         .Case("unsigned",       TokenUnsigned)
         .Case("signed",         TokenSigned)
         .Case("immutable",      TokenConstant)
         .Case("constant",       TokenConstant)
+        .Case("exclusive",      TokenExclusive)
         .Case("pointer",        TokenPointer)
         .Case("nostalgic",      TokenNostalgic)
+        .Case("rarely",         TokenRarely)
+        .Case("pinned",         TokenPinned)
+        .Case("aligned",        TokenAligned)
+        .Case("packed",         TokenPacked)
+        .Case("padded",         TokenPadded)
         .Case("returns",        TokenReturnQualifier)
         //.Case("returning",      TokenReturnQualifier)
         .Case("extends",        TokenExtends)
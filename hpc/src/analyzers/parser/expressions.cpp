@@ -17,6 +17,7 @@
 #include <hpc/ast/exprs/constant.h>
 #include <hpc/ast/exprs/reference.h>
 #include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/shuffle.h>
 
 using namespace hpc;
 
@@ -41,7 +42,35 @@ ast::Expr *parser::ParserInstance::parseMemberAccessExpression(ast::Expr *lhs) {
     if (!lhs) return nullptr;
     
     source::TokenRef operref;
-    if (lexer->getCurrentToken(&operref) != lexer::TokenOperatorMemberAccess) {
+    if (lexer->getCurrentToken(&operref) == '[') {
+        lexer->getNextToken();
+        
+        source::TokenRef indexref;
+        lexer->getCurrentToken(&indexref);
+        ast::Expr *index = parseExpression();
+        if (!index) {
+            if (!lexer->eof()) diags.reportError(diag::ExpectedExpression, &indexref);
+            return nullptr;
+        }
+        
+        source::TokenRef closeref;
+        if (lexer->getCurrentToken(&closeref) != ']') {
+            if (!lexer->eof()) diags.reportError(diag::ExpectedClosedBracket, &closeref);
+            return nullptr;
+        }
+        
+        source::TokenRef *beginref = lhs->tokenRef(ast::PointToBeginOfExpression);
+        
+        lhs = new ast::SubscriptExpr(lhs, index);
+        lhs->tokenRef(ast::PointToOperator, operref);
+        if (beginref) lhs->tokenRef(ast::PointToBeginOfExpression, *beginref);
+        lhs->tokenRef(ast::PointToEndOfExpression, closeref);
+        
+        lexer->getNextToken();
+        return parseMemberAccessExpression(lhs);
+    }
+    
+    if (lexer->getCurrentToken() != lexer::TokenOperatorMemberAccess) {
         return lhs;
     }
     
@@ -117,6 +146,29 @@ ast::Expr *parser::ParserInstance::parseHandSideExpression() {
             source::TokenRef topidref;
             lexer->getLastToken(&topidref);
             
+            // 'length' is not a keyword, as no expression can continue with an identifier after a variable.
+            if (!callsymbol.isNested() && callsymbol.str() == "length" &&
+                lexer->getCurrentToken() == lexer::TokenIdentifier && lexer->getCurrentIdentifier() == "of") {
+                lexer->getNextToken();
+                
+                source::TokenRef entityref;
+                lexer->getCurrentToken(&entityref);
+                ast::Expr *entity = parseHandSideExpression();
+                if (!entity) {
+                    if (!lexer->eof()) diags.reportError(diag::ExpectedExpression, &entityref);
+                    return nullptr;
+                }
+                
+                ast::LengthExpr *length = new ast::LengthExpr(entity);
+                length->tokenRef(ast::PointToBeginOfExpression, exprbeginref);
+                
+                source::TokenRef exprendref;
+                lexer->getLastToken(&exprendref);
+                length->tokenRef(ast::PointToEndOfExpression, exprendref);
+                
+                return length;
+            }
+            
             if (lexer->getCurrentToken() != '(') {
                 ast::VarRef *nvarref = new ast::VarRef(callsymbol);
                 nvarref->tokenRef(ast::PointToBeginOfExpression, exprbeginref);
@@ -148,6 +200,36 @@ ast::Expr *parser::ParserInstance::parseHandSideExpression() {
             hs = fcall;
             break;
         }
+        case lexer::TokenShuffle: {
+            source::TokenRef openref;
+            if (lexer->getNextToken(&openref) != '(') {
+                if (!lexer->eof()) diags.reportError(diag::InvalidArgumentList, &openref);
+                return nullptr;
+            }
+            lexer->getNextToken();
+            
+            ast::ShuffleExpr *shuffle = new ast::ShuffleExpr();
+            
+            source::TokenRef lastexprref;
+            while (lexer->getCurrentToken(&lastexprref) != ')') {
+                ast::Expr *argexpr = parseExpression();
+                if (!argexpr) {
+                    if (!lexer->eof()) diags.reportError(diag::ExpectedExpression, &lastexprref);
+                    return nullptr;
+                }
+                
+                shuffle->addArgument(argexpr);
+                
+                source::TokenRef commaref;
+                if (lexer->getCurrentToken(&commaref) != ',' && lexer->getCurrentToken() != ')') {
+                    if (!lexer->eof()) diags.reportError(diag::InvalidArgumentList, &commaref);
+                    return nullptr;
+                } else if (lexer->getCurrentToken() != ')') lexer->getNextToken();
+            }
+            
+            hs = shuffle;
+            break;
+        }
         case '(': {
             lexer->getNextToken();
             hs = parseExpression();
@@ -12,6 +12,7 @@
 #include <hpc/analyzers/sources.h>
 #include <hpc/diagnostics/diagnostics.h>
 #include <hpc/ast/stmt/ifelse.h>
+#include <hpc/ast/stmt/switchselect.h>
 #include <hpc/ast/stmt/whileuntil.h>
 #include <hpc/ast/stmt/for.h>
 
@@ -21,16 +22,34 @@ bool parser::ParserInstance::parseStatement(ast::Stmt *&parsing, ast::FunctionDe
     return parseSubStatement(parsing, containerFunc);
 }
 
+ast::IfStmt::BranchHint parser::ParserInstance::parseBranchHint() {
+    switch (lexer->getCurrentToken()) {
+        case lexer::TokenLikely:
+            lexer->getNextToken();
+            return ast::IfStmt::Likely;
+        case lexer::TokenUnlikely:
+            lexer->getNextToken();
+            return ast::IfStmt::Unlikely;
+        default:
+            return ast::IfStmt::NoHint;
+    }
+}
+
 bool parser::ParserInstance::parseComplement(ast::Stmt *&statement) {
     switch (lexer->getCurrentToken()) {
         case lexer::TokenIf: {
             lexer->getNextToken();
+            ast::IfStmt::BranchHint hint = parseBranchHint();
             ast::Expr *condition = parseExpression();
             
             if (!condition) {
                 report_eof();
                 abort_parse();
-            } else statement = new ast::IfStmt(condition, statement);
+            } else {
+                ast::IfStmt *ifStmt = new ast::IfStmt(condition, statement);
+                ifStmt->setBranchHint(hint);
+                statement = ifStmt;
+            }
             break;
         }
         case lexer::TokenWhile: {
@@ -158,6 +177,7 @@ bool parser::ParserInstance::parseVarDeclarationStatement(ast::Stmt *&parsing, a
 
 bool parser::ParserInstance::parseIfStatement(ast::Stmt *&parsing, ast::FunctionDecl *containerFunc) {
     lexer->getNextToken();
+    ast::IfStmt::BranchHint hint = parseBranchHint();
     ast::Expr *condition = parseExpression();
     
     if (!condition) {
@@ -176,7 +196,9 @@ bool parser::ParserInstance::parseIfStatement(ast::Stmt *&parsing, ast::Function
     }
     
     report_eof();
-    parsing = new ast::IfStmt(condition, thenBlock, elseBlock);
+    ast::IfStmt *ifStmt = new ast::IfStmt(condition, thenBlock, elseBlock);
+    ifStmt->setBranchHint(hint);
+    parsing = ifStmt;
     return true;
 }
 
@@ -189,8 +211,51 @@ bool parser::ParserInstance::parseSwitchStatement(ast::Stmt *&parsing, ast::Func
         abort_parse();
     }
     
-    // CONTINUE HERE
+    source::TokenRef openbref;
+    if (lexer->getCurrentToken(&openbref) != '{') {
+        report_eof();
+        diags.reportError(diag::ExpectedOpenBrace, &openbref);
+        abort_parse();
+    }
+    
+    // the labels are parsed as statements of the block, so that the statements after each one fall through the next.
+    ast::CompoundStmt *block = nullptr;
+    if (!parseCompoundStatement(block, containerFunc)) return false;
+    
+    parsing = new ast::SwitchStmt(switchingVal, block);
+    return true;
+}
+
+bool parser::ParserInstance::parseCaseLabel(ast::Stmt *&parsing, ast::FunctionDecl *containerFunc) {
+    source::TokenRef qualifref;
+    lexer::token_ty labeltype = lexer->getCurrentToken(&qualifref);
+    lexer->getNextToken();
+    
+    std::vector<ast::Expr *> values;
+    if (labeltype == lexer::TokenCase) {
+        do {
+            if (!values.empty()) lexer->getNextToken();
+            
+            ast::Expr *value = parseExpression();
+            if (!value) {
+                report_eof();
+                abort_parse();
+            }
+            values.push_back(value);
+        } while (lexer->getCurrentToken() == ',');
+    }
+    
+    parsing = new ast::CaseStmt(values);
+    parsing->tokenRef(ast::PointToStatementQualifier, qualifref);
+    
+    source::TokenRef colonref;
+    if (lexer->getCurrentToken(&colonref) != ':') {
+        report_eof();
+        diags.reportError(diag::ExpectedColonAfterCase, &colonref);
+        return true;
+    }
     
+    lexer->getNextToken();
     return true;
 }
 
@@ -331,6 +396,88 @@ bool parser::ParserInstance::parseForIterationStatement(ast::Stmt *&parsing, ast
     return true;
 }
 
+bool parser::ParserInstance::parseLoopDirectives(ast::Stmt *&parsing, ast::FunctionDecl *containerFunc) {
+    ast::LoopDirectives directives;
+    
+    // loop vectorize by 8, interleave by 2, unroll fully, independent
+    do {
+        source::TokenRef directiveref;
+        if (lexer->getNextToken(&directiveref) != lexer::TokenIdentifier) {
+            report_eof();
+            diags.reportError(diag::ExpectedLoopDirective, &directiveref);
+            abort_parse();
+        }
+        
+        std::string directive = lexer->getCurrentIdentifier();
+        lexer->getNextToken();
+        
+        if (directive == "independent") {
+            directives.independent = true;
+            continue;
+        } else if (directive == "unroll" && lexer->getCurrentToken() == lexer::TokenIdentifier && lexer->getCurrentIdentifier() == "fully") {
+            directives.unroll = directives.unrollFully = true;
+            lexer->getNextToken();
+            continue;
+        } else if (directive != "vectorize" && directive != "interleave" && directive != "unroll") {
+            diags.reportError(diag::ExpectedLoopDirective, &directiveref);
+            abort_parse();
+        }
+        
+        unsigned count = 0;
+        source::TokenRef countref;
+        if (lexer->getCurrentToken(&countref) == lexer::TokenIdentifier && lexer->getCurrentIdentifier() == "by") {
+            if (lexer->getNextToken(&countref) != lexer::TokenIntegerLiteral || lexer->currentInteger <= 0) {
+                report_eof();
+                diags.reportError(diag::ExpectedDirectiveCount, &countref) << directive;
+                abort_parse();
+            }
+            
+            count = lexer->currentInteger;
+            lexer->getNextToken();
+        } else if (directive == "interleave") {
+            report_eof();
+            diags.reportError(diag::ExpectedDirectiveCount, &countref) << directive;
+            abort_parse();
+        }
+        
+        if (directive == "vectorize") {
+            // the vectorizer ignores the widths which are not powers of two.
+            if (count & (count - 1)) {
+                diags.reportError(diag::InvalidVectorizeWidth, &countref) << count;
+                abort_parse();
+            }
+            
+            directives.vectorize = true;
+            directives.vectorizeWidth = count;
+        } else if (directive == "interleave") {
+            directives.interleaveCount = count;
+        } else {
+            directives.unroll = true;
+            directives.unrollCount = count;
+        }
+    } while (lexer->getCurrentToken() == ',');
+    
+    source::TokenRef iterref;
+    switch (lexer->getCurrentToken(&iterref)) {
+        case lexer::TokenWhile:
+        case lexer::TokenUntil:
+        case lexer::TokenDo:
+        case lexer::TokenFor:
+            break;
+        default:
+            report_eof();
+            diags.reportError(diag::ExpectedIterationAfterLoop, &iterref);
+            abort_parse();
+    }
+    
+    if (!parseSubStatement(parsing, containerFunc)) return false;
+    
+    if (ast::SimpleIterStmt *iteration = llvm::dyn_cast_or_null<ast::SimpleIterStmt>(parsing)) {
+        iteration->setDirectives(directives);
+    }
+    return true;
+}
+
 bool parser::ParserInstance::parseReturnStatement(ast::Stmt *&parsing, ast::FunctionDecl *containerFunc) {
     source::TokenRef qualifref;
     lexer->getCurrentToken(&qualifref);
@@ -346,7 +493,23 @@ bool parser::ParserInstance::parseReturnStatement(ast::Stmt *&parsing, ast::Func
             abort_parse();
         }
         
-        parsing = new ast::ReturnStmt(containerFunc, retval);
+        ast::ReturnStmt *returnStmt = new ast::ReturnStmt(containerFunc, retval);
+        
+        // return f(x) as tail call
+        if (lexer->getCurrentToken() == lexer::TokenAs) {
+            source::TokenRef tailref;
+            if (lexer->getNextToken(&tailref) != lexer::TokenIdentifier || lexer->getCurrentIdentifier() != "tail" ||
+                lexer->getNextToken(&tailref) != lexer::TokenIdentifier || lexer->getCurrentIdentifier() != "call") {
+                report_eof();
+                diags.reportError(diag::ExpectedTailCall, &tailref);
+                abort_parse();
+            }
+            
+            returnStmt->setTailCallRequired(true);
+            lexer->getNextToken();
+        }
+        
+        parsing = returnStmt;
     } else parsing = new ast::ReturnStmt(containerFunc, nullptr);
     parsing->tokenRef(ast::PointToStatementQualifier, qualifref);
     
@@ -414,6 +577,9 @@ bool parser::ParserInstance::parseSubStatement(ast::Stmt *&parsing, ast::Functio
             return parseIfStatement(parsing, containerFunc);
         case lexer::TokenSwitch:
             return parseSwitchStatement(parsing, containerFunc);
+        case lexer::TokenCase:
+        case lexer::TokenDefault:
+            return parseCaseLabel(parsing, containerFunc);
         case lexer::TokenWhile:
         case lexer::TokenUntil:
             return parsePreConditionedIterationStatement(parsing, containerFunc);
@@ -421,6 +587,8 @@ bool parser::ParserInstance::parseSubStatement(ast::Stmt *&parsing, ast::Functio
             return parsePostConditionedIterationStatement(parsing, containerFunc);
         case lexer::TokenFor:
             return parseForIterationStatement(parsing, containerFunc);
+        case lexer::TokenLoop:
+            return parseLoopDirectives(parsing, containerFunc);
         case lexer::TokenReturnStatement:
             return parseReturnStatement(parsing, containerFunc);
         case lexer::TokenBreak:
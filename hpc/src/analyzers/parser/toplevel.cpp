@@ -237,6 +237,9 @@ bool parser::ParserInstance::parseFunction(ast::NameSpaceDecl *current) {
             case lexer::TokenNostalgic:
                 attributes.nostalgic = true;
                 break;
+            case lexer::TokenRarely:
+                attributes.rarely = true;
+                break;
             case lexer::TokenFunction:
                 finished = true;
                 break;
@@ -270,7 +273,9 @@ bool parser::ParserInstance::parseFunction(ast::NameSpaceDecl *current) {
                 if (lexer->getCurrentToken(&argidref) == lexer::TokenIdentifier) {
                     std::string argname = lexer->getCurrentIdentifier();
                     
-                    args.push_back(new ast::ParamVar(argname, argtype, nullptr));
+                    ast::ParamVar *newarg = new ast::ParamVar(argname, argtype, nullptr);
+                    newarg->tokenRef(ast::PointToVariableIdentifier, argidref);
+                    args.push_back(newarg);
                     
                     source::TokenRef commaref;
                     if (lexer->getNextToken(&commaref) == ',') {
@@ -338,6 +343,45 @@ bool parser::ParserInstance::parseFunction(ast::NameSpaceDecl *current) {
 }
 
 bool parser::ParserInstance::parseClass(ast::NameSpaceDecl *current) {
+    ast::ClassDecl::ClassAttributes attributes;
+    
+    source::TokenRef clskwref;
+    while (lexer->getCurrentToken(&clskwref) != lexer::TokenClass) {
+        switch (lexer->getCurrentToken()) {
+            case lexer::TokenPinned:
+                attributes.pinned = true;
+                break;
+            case lexer::TokenPacked:
+                attributes.packed = true;
+                break;
+            case lexer::TokenAligned:
+            case lexer::TokenPadded: {
+                bool aligned = lexer->getCurrentToken() == lexer::TokenAligned;
+                lexer->getNextToken();
+                lexer->ignoreToIfAny();
+                report_eof();
+                
+                source::TokenRef valueref;
+                if (lexer->getCurrentToken(&valueref) == lexer::TokenIdentifier && lexer->getCurrentIdentifier() == "cacheline") {
+                    if (aligned) attributes.cacheLineAligned = true;
+                    else attributes.cacheLinePadded = true;
+                } else if (lexer->getCurrentToken() == lexer::TokenIntegerLiteral && lexer->currentInteger > 0) {
+                    if (aligned) attributes.alignment = lexer->currentInteger;
+                    else attributes.paddedTo = lexer->currentInteger;
+                } else {
+                    diags.reportError(diag::ExpectedClassAttributeValue, &valueref) << (aligned ? "aligned to" : "padded to");
+                    abort_parse();
+                }
+                break;
+            }
+            default:
+                diags.reportError(diag::ExpectedTokenClass, &clskwref);
+                abort_parse();
+        }
+        lexer->getNextToken();
+        report_eof();
+    }
+    
     source::TokenRef clsnameref;
     if (lexer->getNextToken(&clsnameref) == lexer::TokenIdentifier) {
         std::string classname = lexer->getCurrentIdentifier();
@@ -381,7 +425,7 @@ bool parser::ParserInstance::parseClass(ast::NameSpaceDecl *current) {
         source::TokenRef clsbodyref;
         if (lexer->getCurrentToken(&clsbodyref) == '{') {
             
-            ast::ClassDecl *newclass = builder.createClassDecl(classname);
+            ast::ClassDecl *newclass = builder.createClassDecl(classname, attributes);
             newclass->tokenRef(ast::PointToVariableIdentifier, clsnameref);
             
             lexer->getNextToken();
@@ -544,8 +588,13 @@ bool parser::ParserInstance::parseTopLevel(ast::NameSpaceDecl *current) {
             return parseAliasDecl(current);
         case lexer::TokenFunction:
         case lexer::TokenNostalgic:
+        case lexer::TokenRarely:
             return parseFunction(current);
         case lexer::TokenClass:
+        case lexer::TokenPinned:
+        case lexer::TokenAligned:
+        case lexer::TokenPacked:
+        case lexer::TokenPadded:
             return parseClass(current);
         case lexer::TokenProtocol:
             return parseProtocol(current);
@@ -13,11 +13,44 @@
 #include <hpc/diagnostics/diagnostics.h>
 #include <hpc/ast/types/base.h>
 #include <hpc/ast/types/builtintype.h>
+#include <hpc/ast/types/vectortype.h>
+#include <hpc/ast/types/arraytype.h>
 
 #define break_while() { shouldExit = true; continue; }
 
 using namespace hpc;
 
+/*!
+ \brief Returns \c type with the qualifiers parsed before the keyword introducing it.
+ */
+static ast::Type *qualifyType(ast::Type *type, ast::TypeQualifiers *typeQuals) {
+    if (typeQuals->isConstant()) {
+        ast::QualifiedType *qualType = new ast::QualifiedType(type);
+        qualType->setConstant(true);
+        return qualType;
+    }
+    return type;
+}
+
+/*!
+ \brief Returns \c type marked \c exclusive if the qualifier was parsed before it. Unlike \c constant, the qualifier applies to the whole type, which must be a pointer or a slice.
+ */
+static ast::Type *makeExclusive(ast::Type *type, ast::TypeQualifiers *typeQuals) {
+    if (typeQuals->isExclusive()) {
+        ast::QualifiedType *qualType = new ast::QualifiedType(type);
+        qualType->setExclusive(true);
+        return qualType;
+    }
+    return type;
+}
+
+/*!
+ \brief Returns a vector type with the given number of lanes of \c elementType, with the qualifiers parsed before the \c vector keyword.
+ */
+static ast::Type *makeVectorType(ast::Type *elementType, unsigned lanes, ast::TypeQualifiers *typeQuals) {
+    return qualifyType(ast::VectorType::get(elementType, lanes), typeQuals);
+}
+
 
 ast::TypeQualifiers *parser::ParserInstance::parseQualifiers(bool report) {
     source::TokenRef lastidref;
@@ -32,6 +65,9 @@ ast::TypeQualifiers *parser::ParserInstance::parseQualifiers(bool report) {
                 } else typeQuals->setConstant(true);
                 break;
             }
+            case lexer::TokenExclusive:
+                typeQuals->setExclusive(true);
+                break;
 
             default:
                 return typeQuals;
@@ -59,6 +95,8 @@ ast::Type *parser::ParserInstance::parseType(bool report) {
         QualSigned
     } signQual = QualDefault;
     
+    unsigned vectorLanes = 0; // the lanes of the vector type being parsed, if any.
+    
     bool shouldExit = false;
     do {
         
@@ -87,11 +125,79 @@ ast::Type *parser::ParserInstance::parseType(bool report) {
                 signQual = QualSigned;
                 lexer->getNextToken();
                 break;
+            case lexer::TokenVector: {
+                if (parsedType || vectorLanes) {
+                    diags.reportError(diag::ExpectedType, &lastidref);
+                    return nullptr;
+                }
+                
+                if (lexer->getNextToken() == lexer::TokenIdentifier && lexer->getCurrentIdentifier() == "of") lexer->getNextToken();
+                
+                source::TokenRef lanesref;
+                if (lexer->getCurrentToken(&lanesref) != lexer::TokenIntegerLiteral || lexer->currentInteger <= 0) {
+                    if (!lexer->eof()) diags.reportError(diag::ExpectedVectorLanes, &lanesref);
+                    return nullptr;
+                }
+                
+                vectorLanes = lexer->currentInteger;
+                lexer->getNextToken();
+                break;
+            }
+            case lexer::TokenArray:
+            case lexer::TokenSlice: {
+                // the element type is everything after the keyword, so arrays of arrays and of pointers can be written.
+                lexer::token_ty keyword = lexer->getCurrentToken();
+                if (parsedType || vectorLanes || signQual != QualDefault) {
+                    diags.reportError(diag::ExpectedType, &lastidref);
+                    return nullptr;
+                }
+                
+                if (lexer->getNextToken() == lexer::TokenIdentifier && lexer->getCurrentIdentifier() == "of") lexer->getNextToken();
+                
+                uint64_t length = 0;
+                if (keyword == lexer::TokenArray) {
+                    source::TokenRef lengthref;
+                    if (lexer->getCurrentToken(&lengthref) != lexer::TokenIntegerLiteral || lexer->currentInteger <= 0) {
+                        if (!lexer->eof()) diags.reportError(diag::ExpectedArrayLength, &lengthref);
+                        return nullptr;
+                    }
+                    
+                    length = lexer->currentInteger;
+                    lexer->getNextToken();
+                }
+                
+                ast::Type *elementType = parseType(report);
+                if (!elementType) return nullptr;
+                
+                if (keyword == lexer::TokenArray) {
+                    // array of N T stored by columns
+                    bool storedByColumns = false;
+                    if (lexer->getCurrentToken() == lexer::TokenIdentifier && lexer->getCurrentIdentifier() == "stored") {
+                        source::TokenRef orderref;
+                        if (lexer->getNextToken() != lexer::TokenIdentifier || lexer->getCurrentIdentifier() != "by" ||
+                            lexer->getNextToken(&orderref) != lexer::TokenIdentifier || lexer->getCurrentIdentifier() != "columns") {
+                            if (!lexer->eof()) diags.reportError(diag::ExpectedStorageOrder, &orderref);
+                            return nullptr;
+                        }
+                        
+                        storedByColumns = true;
+                        lexer->getNextToken();
+                    }
+                    
+                    return makeExclusive(qualifyType(ast::ArrayType::get(elementType, length, storedByColumns), typeQuals), typeQuals);
+                }
+                return makeExclusive(qualifyType(ast::SliceType::get(elementType), typeQuals), typeQuals);
+            }
             case lexer::TokenPointer:
                 if (!parsedType) {
                     diags.reportError(diag::ExpectedType, &lastidref);
                     return nullptr;
                 } else {
+                    if (vectorLanes) {
+                        parsedType = makeVectorType(parsedType, vectorLanes, typeQuals);
+                        vectorLanes = 0;
+                    }
+                    
                     // FIXME wrap with QualifiedType if needed.
                     parsedType = parsedType->pointerTo();
                 }
@@ -143,7 +249,7 @@ ast::Type *parser::ParserInstance::parseType(bool report) {
                         diags.reportError(diag::TypeCannotBeSignedOrUnsigned, &lastidref) << parsedType->asString();
                     }
                     
-                    if (parsedType && !typeQuals->isDefault()) {
+                    if (parsedType && typeQuals->isConstant() && !vectorLanes) {
                         ast::QualifiedType *qualType = new ast::QualifiedType(parsedType);
                         qualType->setConstant(typeQuals->isConstant());
                         parsedType = qualType;
@@ -159,6 +265,9 @@ ast::Type *parser::ParserInstance::parseType(bool report) {
         
     } while (!shouldExit);
     
+    if (parsedType && vectorLanes) {
+        parsedType = makeVectorType(parsedType, vectorLanes, typeQuals);
+    }
     
     if (!parsedType) {
         
@@ -172,6 +281,6 @@ ast::Type *parser::ParserInstance::parseType(bool report) {
         }
     }
     
-    return parsedType;
+    return makeExclusive(parsedType, typeQuals);
 }
 
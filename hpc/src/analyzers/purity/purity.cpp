@@ -0,0 +1,334 @@
+// => src/analyzers/purity/purity.cpp
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#include <hpc/analyzers/purity/purity.h>
+#include <hpc/ast/unit.h>
+#include <hpc/ast/decls/namespace.h>
+#include <hpc/ast/decls/variable.h>
+#include <hpc/ast/decls/function.h>
+#include <hpc/ast/types/base.h>
+#include <hpc/ast/stmt/statement.h>
+#include <hpc/ast/stmt/ifelse.h>
+#include <hpc/ast/stmt/switchselect.h>
+#include <hpc/ast/stmt/whileuntil.h>
+#include <hpc/ast/stmt/for.h>
+#include <hpc/ast/exprs/binary.h>
+#include <hpc/ast/exprs/unary.h>
+#include <hpc/ast/exprs/castings.h>
+#include <hpc/ast/exprs/reference.h>
+#include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/shuffle.h>
+
+using namespace hpc;
+
+/*!
+ \brief Returns the variable reference \c expression is made of, ignoring implicit casts, or \c nullptr if it is not a plain variable reference.
+ */
+static ast::VarRef *getPlainVarRef(ast::Expr *expression) {
+    while (ast::ImplicitCastExpr *cast = llvm::dyn_cast<ast::ImplicitCastExpr>(expression))
+        expression = cast->getExpression();
+
+    return llvm::dyn_cast<ast::VarRef>(expression);
+}
+
+/*!
+ \brief Returns whether \c subscript accesses an element of a slice, which is stored outside the slice variable.
+ */
+static bool isSliceElement(ast::SubscriptExpr *subscript) {
+    return subscript->getEntity()->evalType()->isSliceType();
+}
+
+/*!
+ \brief Returns the variable whose memory is accessed by \c expression, if \c expression is a variable or a part of a variable.
+ */
+static ast::Var *getAccessedVar(ast::Expr *expression) {
+    if (ast::VarRef *varRef = llvm::dyn_cast<ast::VarRef>(expression)) return varRef->getVar();
+    if (ast::FieldRef *fieldRef = llvm::dyn_cast<ast::FieldRef>(expression)) return getAccessedVar(fieldRef->getEntity());
+    if (ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(expression)) {
+        if (!isSliceElement(subscript)) return getAccessedVar(subscript->getEntity());
+    }
+    return nullptr;
+}
+
+
+void purity::PurityAnalysis::collectFunctions(ast::NameSpaceDecl *nameSpace) {
+    for (ast::Decl *decl : nameSpace->getDeclarations()) {
+        if (ast::FunctionDecl *function = llvm::dyn_cast<ast::FunctionDecl>(decl)) {
+            if (function->getStatementsBlock()) takeDecl(function);
+        } else if (ast::NameSpaceDecl *innerNameSpace = llvm::dyn_cast<ast::NameSpaceDecl>(decl)) {
+            collectFunctions(innerNameSpace);
+        }
+    }
+}
+
+int purity::PurityAnalysis::getPointerArgIndex(ast::Var *var) const {
+    if (!current || !llvm::isa<ast::ParamVar>(var) || !var->getType()->getCanonicalType()->isPointerType()) return -1;
+
+    const std::vector<ast::ParamVar *> &arguments = current->getArgs();
+    for (unsigned i = 0; i < arguments.size(); i++) {
+        if (arguments[i] == var) return i;
+    }
+    return -1;
+}
+
+bool purity::PurityAnalysis::canCall(ast::FunctionDecl *function, ast::FunctionDecl *target) const {
+    std::set<ast::FunctionDecl *> visited;
+    std::vector<ast::FunctionDecl *> worklist = { function };
+
+    while (!worklist.empty()) {
+        ast::FunctionDecl *caller = worklist.back();
+        worklist.pop_back();
+
+        auto found = summaries.find(caller);
+        if (found == summaries.end()) return true; // a function outside the program may call anything.
+
+        for (ast::FunctionDecl *callee : found->second.callees) {
+            if (callee == target) return true;
+            if (visited.insert(callee).second) worklist.push_back(callee);
+        }
+    }
+
+    return false;
+}
+
+void purity::PurityAnalysis::propagate() {
+    for (auto &entry : summaries) {
+        entry.second.mayRecurse = canCall(entry.first, entry.first);
+        if (entry.second.mayRecurse) entry.second.mayNotReturn = true;
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        for (auto &entry : summaries) {
+            FunctionSummary &summary = entry.second;
+
+            for (ast::FunctionDecl *callee : summary.callees) {
+                const FunctionSummary *calleeSummary = getSummary(callee);
+
+                bool reads = calleeSummary ? calleeSummary->readsMemory : true;
+                bool writes = calleeSummary ? calleeSummary->writesMemory : true;
+                bool mayNotReturn = calleeSummary ? calleeSummary->mayNotReturn : true;
+
+                if ((reads && !summary.readsMemory) || (writes && !summary.writesMemory) || (mayNotReturn && !summary.mayNotReturn)) {
+                    summary.readsMemory |= reads;
+                    summary.writesMemory |= writes;
+                    summary.mayNotReturn |= mayNotReturn;
+                    changed = true;
+                }
+            }
+        }
+
+        for (const ArgumentFlow &flow : argumentFlows) {
+            std::vector<bool> &capturedArgs = summaries[flow.caller].capturedArgs;
+            if (capturedArgs[flow.callerArg]) continue;
+
+            if (!isNoCapture(flow.callee, flow.calleeArg)) {
+                capturedArgs[flow.callerArg] = true;
+                changed = true;
+            }
+        }
+    }
+}
+
+void purity::PurityAnalysis::analyze(ast::AbstractSyntaxTree *ast) {
+    assert(ast && "No AST has been passed to the purity analysis.");
+
+    collectFunctions(ast->getRootNameSpace());
+    propagate();
+}
+
+const purity::FunctionSummary *purity::PurityAnalysis::getSummary(ast::FunctionDecl *function) const {
+    auto found = summaries.find(function);
+    if (found == summaries.end()) return nullptr;
+
+    return &found->second;
+}
+
+bool purity::PurityAnalysis::isReadNone(ast::FunctionDecl *function) const {
+    // a call that may not return cannot be removed or moved, even if it does not touch memory.
+    const FunctionSummary *summary = getSummary(function);
+    return summary && !summary->readsMemory && !summary->writesMemory && !summary->mayNotReturn;
+}
+
+bool purity::PurityAnalysis::isReadOnly(ast::FunctionDecl *function) const {
+    const FunctionSummary *summary = getSummary(function);
+    return summary && !summary->writesMemory && !summary->mayNotReturn;
+}
+
+bool purity::PurityAnalysis::writesObjectArgs(ast::FunctionDecl *function) const {
+    const FunctionSummary *summary = getSummary(function);
+    return !summary || summary->writesObjectArgs;
+}
+
+bool purity::PurityAnalysis::isNoRecurse(ast::FunctionDecl *function) const {
+    const FunctionSummary *summary = getSummary(function);
+    return summary && !summary->mayRecurse;
+}
+
+bool purity::PurityAnalysis::alwaysReturns(ast::FunctionDecl *function) const {
+    const FunctionSummary *summary = getSummary(function);
+    return summary && !summary->mayNotReturn;
+}
+
+bool purity::PurityAnalysis::isNoCapture(ast::FunctionDecl *function, unsigned argNo) const {
+    const FunctionSummary *summary = getSummary(function);
+    if (!summary || argNo >= summary->capturedArgs.size()) return false;
+
+    return function->getArgs()[argNo]->getType()->getCanonicalType()->isPointerType() && !summary->capturedArgs[argNo];
+}
+
+void purity::PurityAnalysis::visitFunctionDecl(ast::FunctionDecl *function) {
+    current = function;
+    currentSummary = &summaries[function];
+    currentSummary->capturedArgs.assign(function->getArgs().size(), false);
+
+    scan(function->getStatementsBlock());
+
+    current = nullptr;
+    currentSummary = nullptr;
+}
+
+void purity::PurityAnalysis::visitCompoundStmt(ast::CompoundStmt *statement) {
+    for (ast::Stmt *stmt : statement->statements()) scan(stmt);
+}
+
+void purity::PurityAnalysis::visitVarDeclStmt(ast::VarDeclStmt *statement) {
+    for (ast::Var *var : statement->getDeclaredVariables()) scan(var->getInitialValue());
+}
+
+void purity::PurityAnalysis::visitReturnStmt(ast::ReturnStmt *statement) {
+    scan(statement->getReturnValue());
+}
+
+void purity::PurityAnalysis::visitIfStmt(ast::IfStmt *statement) {
+    scan(statement->getCondition());
+    scan(statement->getThenBlock());
+    scan(statement->getElseBlock());
+}
+
+void purity::PurityAnalysis::visitSwitchStmt(ast::SwitchStmt *statement) {
+    scan(statement->getSelectionValue());
+    scan(statement->getBlock());
+}
+
+void purity::PurityAnalysis::visitCaseStmt(ast::CaseStmt *statement) {
+    for (ast::Expr *value : statement->getValues()) scan(value);
+}
+
+void purity::PurityAnalysis::visitSimpleIterStmt(ast::SimpleIterStmt *statement) {
+    currentSummary->mayNotReturn = true; // termination of loops is not proven.
+
+    scan(statement->getCondition());
+    scan(statement->getBlock());
+}
+
+void purity::PurityAnalysis::visitForStmt(ast::ForStmt *statement) {
+    for (ast::Stmt *stmt : statement->getInitStatements()) scan(stmt);
+    for (ast::Stmt *stmt : statement->getEndStatements()) scan(stmt);
+
+    visitSimpleIterStmt(statement);
+}
+
+void purity::PurityAnalysis::visitImplicitCastExpr(ast::ImplicitCastExpr *cast) {
+    scan(cast->getExpression());
+}
+
+void purity::PurityAnalysis::visitEvalExpr(ast::EvalExpr *cast) {
+    scan(cast->getExpression());
+}
+
+void purity::PurityAnalysis::visitBinaryExpr(ast::BinaryExpr *expression) {
+    scan(expression->getLHS());
+    scan(expression->getRHS());
+}
+
+void purity::PurityAnalysis::visitComparisonExpr(ast::ComparisonExpr *expression) {
+    // comparing a pointer argument does not capture it.
+    for (ast::Expr *operand : { expression->getLHS(), expression->getRHS() }) {
+        ast::VarRef *varRef = getPlainVarRef(operand);
+        if (!varRef || getPointerArgIndex(varRef->getVar()) < 0) scan(operand);
+    }
+}
+
+void purity::PurityAnalysis::visitAssignmentExpr(ast::AssignmentExpr *expression) {
+    ast::Expr *lhs = expression->getLHS();
+
+    if (ast::Var *var = getAccessedVar(lhs)) {
+        if (llvm::isa<ast::GlobalVar>(var)) {
+            currentSummary->writesMemory = true;
+            currentSummary->readsMemory = true; // compound assignments read the old value.
+        } else if (llvm::isa<ast::ParamVar>(var)) {
+            ast::Type *type = var->getType();
+            if (type->getFormat() == ast::TypeFormatCompound || type->isArrayType()) currentSummary->writesObjectArgs = true;
+        }
+        
+        // the lane index is evaluated like any other value.
+        if (ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(lhs)) scan(subscript->getIndex());
+    } else {
+        if (ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(lhs)) {
+            if (isSliceElement(subscript)) currentSummary->writesMemory = true; // the elements may be anywhere.
+        }
+        scan(lhs);
+    }
+
+    scan(expression->getRHS());
+}
+
+void purity::PurityAnalysis::visitUnaryExpr(ast::UnaryExpr *expression) {
+    scan(expression->getOperand());
+}
+
+void purity::PurityAnalysis::visitVarRef(ast::VarRef *varRef) {
+    ast::Var *var = varRef->getVar();
+
+    if (llvm::isa<ast::GlobalVar>(var)) {
+        currentSummary->readsMemory = true;
+    } else {
+        int argNo = getPointerArgIndex(var);
+        if (argNo >= 0) currentSummary->capturedArgs[argNo] = true; // the pointer is copied somewhere.
+    }
+}
+
+void purity::PurityAnalysis::visitFunctionCall(ast::FunctionCall *functionCall) {
+    ast::FunctionDecl *callee = functionCall->getFunctionDecl();
+    currentSummary->callees.insert(callee);
+
+    const std::vector<ast::Expr *> &actualParams = functionCall->getActualParams();
+    for (unsigned i = 0; i < actualParams.size(); i++) {
+        ast::VarRef *varRef = getPlainVarRef(actualParams[i]);
+        int argNo = varRef ? getPointerArgIndex(varRef->getVar()) : -1;
+
+        if (argNo >= 0) {
+            argumentFlows.push_back({ current, (unsigned)argNo, callee, i });
+        } else {
+            scan(actualParams[i]);
+        }
+    }
+}
+
+void purity::PurityAnalysis::visitFieldRef(ast::FieldRef *fieldRef) {
+    scan(fieldRef->getEntity());
+}
+
+void purity::PurityAnalysis::visitSubscriptExpr(ast::SubscriptExpr *subscript) {
+    if (isSliceElement(subscript)) currentSummary->readsMemory = true;
+
+    scan(subscript->getEntity());
+    scan(subscript->getIndex());
+}
+
+void purity::PurityAnalysis::visitLengthExpr(ast::LengthExpr *length) {
+    scan(length->getEntity());
+}
+
+void purity::PurityAnalysis::visitShuffleExpr(ast::ShuffleExpr *shuffle) {
+    for (ast::Expr *argument : shuffle->getArguments()) scan(argument);
+}
@@ -0,0 +1,197 @@
+// => src/analyzers/reachability/reachability.cpp
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#include <hpc/analyzers/reachability/reachability.h>
+#include <hpc/ast/unit.h>
+#include <hpc/ast/decls/namespace.h>
+#include <hpc/ast/decls/variable.h>
+#include <hpc/ast/decls/function.h>
+#include <hpc/ast/decls/class.h>
+#include <hpc/ast/types/base.h>
+#include <hpc/ast/types/compoundtype.h>
+#include <hpc/ast/types/arraytype.h>
+#include <hpc/ast/stmt/statement.h>
+#include <hpc/ast/stmt/ifelse.h>
+#include <hpc/ast/stmt/switchselect.h>
+#include <hpc/ast/stmt/whileuntil.h>
+#include <hpc/ast/stmt/for.h>
+#include <hpc/ast/exprs/binary.h>
+#include <hpc/ast/exprs/unary.h>
+#include <hpc/ast/exprs/castings.h>
+#include <hpc/ast/exprs/reference.h>
+#include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/shuffle.h>
+
+using namespace hpc;
+
+bool reachability::ReachabilityAnalysis::isRoot(ast::FunctionDecl *function) {
+    return function->isMainFunction() || (function->isNostalgic() && function->getStatementsBlock());
+}
+
+bool reachability::ReachabilityAnalysis::isRoot(ast::GlobalVar *var) {
+    // the initial value is computed by the global initialization function, which runs even if the variable is never read.
+    return var->getInitialValue() && !var->hasConstantInitializer();
+}
+
+void reachability::ReachabilityAnalysis::markReachable(ast::Decl *decl) {
+    if (decl && reachable.insert(decl).second) {
+        worklist.push_back(decl);
+    }
+}
+
+void reachability::ReachabilityAnalysis::markType(ast::Type *type) {
+    if (!type) return;
+    type = type->getCanonicalType();
+
+    if (type->isPointerType()) {
+        markType(type->getPointedType());
+    } else if (ast::ArrayType *arrayTy = llvm::dyn_cast<ast::ArrayType>(type)) {
+        markType(arrayTy->getElementType());
+    } else if (ast::SliceType *sliceTy = llvm::dyn_cast<ast::SliceType>(type)) {
+        markType(sliceTy->getElementType());
+    } else if (ast::ClassType *classTy = llvm::dyn_cast<ast::ClassType>(type)) {
+        markReachable(classTy->getDeclarator());
+    }
+}
+
+void reachability::ReachabilityAnalysis::collectRoots(ast::NameSpaceDecl *nameSpace) {
+    for (ast::Decl *decl : nameSpace->getDeclarations()) {
+        if (ast::FunctionDecl *function = llvm::dyn_cast<ast::FunctionDecl>(decl)) {
+            if (isRoot(function)) markReachable(function);
+        } else if (ast::GlobalVar *var = llvm::dyn_cast<ast::GlobalVar>(decl)) {
+            if (isRoot(var)) markReachable(var);
+        } else if (ast::NameSpaceDecl *innerNameSpace = llvm::dyn_cast<ast::NameSpaceDecl>(decl)) {
+            collectRoots(innerNameSpace);
+        }
+    }
+}
+
+void reachability::ReachabilityAnalysis::analyze(ast::AbstractSyntaxTree *ast) {
+    assert(ast && "No AST has been passed to the reachability analysis.");
+
+    collectRoots(ast->getRootNameSpace());
+
+    while (!worklist.empty()) {
+        ast::Decl *decl = worklist.back();
+        worklist.pop_back();
+
+        takeDecl(decl);
+    }
+}
+
+void reachability::ReachabilityAnalysis::visitGlobalVar(ast::GlobalVar *var) {
+    markType(var->getType());
+    scan(var->getInitialValue());
+}
+
+void reachability::ReachabilityAnalysis::visitFunctionDecl(ast::FunctionDecl *function) {
+    markType(function->getReturnType());
+
+    for (ast::ParamVar *arg : function->getArgs()) {
+        markType(arg->getType());
+    }
+
+    scan(function->getStatementsBlock());
+}
+
+void reachability::ReachabilityAnalysis::visitClassDecl(ast::ClassDecl *classDecl) {
+    for (ast::FieldDecl *field : classDecl->getFields()) {
+        markType(field->getType());
+        scan(field->getInitialValue());
+    }
+}
+
+void reachability::ReachabilityAnalysis::visitCompoundStmt(ast::CompoundStmt *statement) {
+    for (ast::Stmt *stmt : statement->statements()) scan(stmt);
+}
+
+void reachability::ReachabilityAnalysis::visitVarDeclStmt(ast::VarDeclStmt *statement) {
+    for (ast::Var *var : statement->getDeclaredVariables()) {
+        markType(var->getType());
+        scan(var->getInitialValue());
+    }
+}
+
+void reachability::ReachabilityAnalysis::visitReturnStmt(ast::ReturnStmt *statement) {
+    scan(statement->getReturnValue());
+}
+
+void reachability::ReachabilityAnalysis::visitIfStmt(ast::IfStmt *statement) {
+    scan(statement->getCondition());
+    scan(statement->getThenBlock());
+    scan(statement->getElseBlock());
+}
+
+void reachability::ReachabilityAnalysis::visitSwitchStmt(ast::SwitchStmt *statement) {
+    scan(statement->getSelectionValue());
+    scan(statement->getBlock());
+}
+
+void reachability::ReachabilityAnalysis::visitCaseStmt(ast::CaseStmt *statement) {
+    for (ast::Expr *value : statement->getValues()) scan(value);
+}
+
+void reachability::ReachabilityAnalysis::visitSimpleIterStmt(ast::SimpleIterStmt *statement) {
+    scan(statement->getCondition());
+    scan(statement->getBlock());
+}
+
+void reachability::ReachabilityAnalysis::visitForStmt(ast::ForStmt *statement) {
+    for (ast::Stmt *stmt : statement->getInitStatements()) scan(stmt);
+    for (ast::Stmt *stmt : statement->getEndStatements()) scan(stmt);
+
+    visitSimpleIterStmt(statement);
+}
+
+void reachability::ReachabilityAnalysis::visitImplicitCastExpr(ast::ImplicitCastExpr *cast) {
+    markType(cast->getDestination());
+    scan(cast->getExpression());
+}
+
+void reachability::ReachabilityAnalysis::visitEvalExpr(ast::EvalExpr *cast) {
+    scan(cast->getExpression());
+}
+
+void reachability::ReachabilityAnalysis::visitBinaryExpr(ast::BinaryExpr *expression) {
+    scan(expression->getLHS());
+    scan(expression->getRHS());
+}
+
+void reachability::ReachabilityAnalysis::visitUnaryExpr(ast::UnaryExpr *expression) {
+    scan(expression->getOperand());
+}
+
+void reachability::ReachabilityAnalysis::visitVarRef(ast::VarRef *varRef) {
+    if (llvm::isa<ast::GlobalVar>(varRef->getVar())) {
+        markReachable(varRef->getVar());
+    }
+}
+
+void reachability::ReachabilityAnalysis::visitFunctionCall(ast::FunctionCall *functionCall) {
+    for (ast::Expr *param : functionCall->getActualParams()) scan(param);
+
+    markReachable(functionCall->getFunctionDecl());
+}
+
+void reachability::ReachabilityAnalysis::visitFieldRef(ast::FieldRef *fieldRef) {
+    scan(fieldRef->getEntity());
+}
+
+void reachability::ReachabilityAnalysis::visitSubscriptExpr(ast::SubscriptExpr *subscript) {
+    scan(subscript->getEntity());
+    scan(subscript->getIndex());
+}
+
+void reachability::ReachabilityAnalysis::visitLengthExpr(ast::LengthExpr *length) {
+    scan(length->getEntity());
+}
+
+void reachability::ReachabilityAnalysis::visitShuffleExpr(ast::ShuffleExpr *shuffle) {
+    for (ast::Expr *argument : shuffle->getArguments()) scan(argument);
+}
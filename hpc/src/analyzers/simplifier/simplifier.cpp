@@ -0,0 +1,543 @@
+// => src/analyzers/simplifier/simplifier.cpp
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#include <hpc/analyzers/simplifier/simplifier.h>
+#include <hpc/ast/unit.h>
+#include <hpc/ast/decls/namespace.h>
+#include <hpc/ast/decls/variable.h>
+#include <hpc/ast/decls/function.h>
+#include <hpc/ast/decls/class.h>
+#include <hpc/ast/types/builtintype.h>
+#include <hpc/ast/types/arraytype.h>
+#include <hpc/ast/stmt/statement.h>
+#include <hpc/ast/stmt/ifelse.h>
+#include <hpc/ast/stmt/switchselect.h>
+#include <hpc/ast/stmt/whileuntil.h>
+#include <hpc/ast/stmt/for.h>
+#include <hpc/ast/exprs/binary.h>
+#include <hpc/ast/exprs/unary.h>
+#include <hpc/ast/exprs/castings.h>
+#include <hpc/ast/exprs/constant.h>
+#include <hpc/ast/exprs/reference.h>
+#include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/shuffle.h>
+
+#include <llvm/ADT/APFloat.h>
+#include <llvm/ADT/APSInt.h>
+
+using namespace hpc;
+
+namespace {
+    /*!
+     \brief The value of a literal, either an integer or a floating point number.
+     */
+    struct FoldedValue {
+        bool isFloatingPoint = false;
+        llvm::APSInt integer;
+        llvm::APFloat floating = llvm::APFloat(0.0);
+    };
+}
+
+/*!
+ \brief Returns the canonical built-in type of \c type if there is a literal class that can hold its values, \c nullptr otherwise.
+ */
+static ast::BuiltinType *getFoldableType(ast::Type *type) {
+    if (!type) return nullptr;
+
+    ast::BuiltinType *builtinTy = llvm::dyn_cast<ast::BuiltinType>(type->getCanonicalType());
+    if (!builtinTy) return nullptr;
+
+    switch (builtinTy->getBuiltinTypeID()) {
+        case ast::BuiltinType::Boolean:
+        case ast::BuiltinType::Character:
+        case ast::BuiltinType::SignedInteger:
+        case ast::BuiltinType::UnsignedInteger:
+        case ast::BuiltinType::SignedLong:
+        case ast::BuiltinType::UnsignedLong:
+        case ast::BuiltinType::Float:
+        case ast::BuiltinType::Double:
+            return builtinTy;
+        default:
+            return nullptr;
+    }
+}
+
+static unsigned getBitWidth(ast::BuiltinType *type) {
+    if (type->isBooleanType()) return 1;
+    return type->getMagnitude() * 8;
+}
+
+static const llvm::fltSemantics &getSemantics(ast::BuiltinType *type) {
+    if (type->getBuiltinTypeID() == ast::BuiltinType::Float) return llvm::APFloat::IEEEsingle();
+    return llvm::APFloat::IEEEdouble();
+}
+
+static bool getLiteralValue(ast::Expr *expression, FoldedValue &value) {
+    if (ast::CharLiteral *literal = llvm::dyn_cast<ast::CharLiteral>(expression)) {
+        value.integer = llvm::APSInt(llvm::APInt(8, (uint8_t)literal->getValue()), /*isUnsigned=*/true);
+    } else if (ast::IntegerLiteral *literal = llvm::dyn_cast<ast::IntegerLiteral>(expression)) {
+        value.integer = llvm::APSInt(llvm::APInt(32, literal->getValue(), /*isSigned=*/true), /*isUnsigned=*/false);
+    } else if (ast::UIntegerLiteral *literal = llvm::dyn_cast<ast::UIntegerLiteral>(expression)) {
+        value.integer = llvm::APSInt(llvm::APInt(32, literal->getValue()), /*isUnsigned=*/true);
+    } else if (ast::LongLiteral *literal = llvm::dyn_cast<ast::LongLiteral>(expression)) {
+        value.integer = llvm::APSInt(llvm::APInt(64, literal->getValue(), /*isSigned=*/true), /*isUnsigned=*/false);
+    } else if (ast::ULongLiteral *literal = llvm::dyn_cast<ast::ULongLiteral>(expression)) {
+        value.integer = llvm::APSInt(llvm::APInt(64, literal->getValue()), /*isUnsigned=*/true);
+    } else if (ast::BoolLiteral *literal = llvm::dyn_cast<ast::BoolLiteral>(expression)) {
+        value.integer = llvm::APSInt(llvm::APInt(1, literal->getValue() ? 1 : 0), /*isUnsigned=*/true);
+    } else if (ast::FloatLiteral *literal = llvm::dyn_cast<ast::FloatLiteral>(expression)) {
+        value.isFloatingPoint = true;
+        value.floating = llvm::APFloat(literal->getValue());
+    } else if (ast::DoubleLiteral *literal = llvm::dyn_cast<ast::DoubleLiteral>(expression)) {
+        value.isFloatingPoint = true;
+        value.floating = llvm::APFloat(literal->getValue());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static ast::Expr *createLiteral(ast::BuiltinType *type, const FoldedValue &value) {
+    switch (type->getBuiltinTypeID()) {
+        case ast::BuiltinType::Boolean:
+            return new ast::BoolLiteral(value.integer.getBoolValue());
+        case ast::BuiltinType::Character:
+            return new ast::CharLiteral((runtime::utf7_char_ty)value.integer.getZExtValue());
+        case ast::BuiltinType::SignedInteger:
+            return new ast::IntegerLiteral((runtime::int32_ty)value.integer.getSExtValue());
+        case ast::BuiltinType::UnsignedInteger:
+            return new ast::UIntegerLiteral((runtime::uint32_ty)value.integer.getZExtValue());
+        case ast::BuiltinType::SignedLong:
+            return new ast::LongLiteral((runtime::int64_ty)value.integer.getSExtValue());
+        case ast::BuiltinType::UnsignedLong:
+            return new ast::ULongLiteral((runtime::uint64_ty)value.integer.getZExtValue());
+        case ast::BuiltinType::Float:
+            return new ast::FloatLiteral(value.floating.convertToFloat());
+        case ast::BuiltinType::Double:
+            return new ast::DoubleLiteral(value.floating.convertToDouble());
+        default:
+            llvm_unreachable("Built-in type cannot be folded.");
+    }
+}
+
+/*!
+ \brief Makes \c replacement take the source location of \c original, and returns it.
+ */
+static ast::Expr *replaceWith(ast::Expr *original, ast::Expr *replacement) {
+    if (source::TokenRef *beginref = original->tokenRef(ast::PointToBeginOfExpression))
+        replacement->tokenRef(ast::PointToBeginOfExpression, *beginref);
+    if (source::TokenRef *endref = original->tokenRef(ast::PointToEndOfExpression))
+        replacement->tokenRef(ast::PointToEndOfExpression, *endref);
+
+    return replacement;
+}
+
+/*!
+ \brief Converts \c value from type \c from to type \c to, as \c ModuleBuilder::visitImplicitCastExpr() would do.
+ \return \c false if the conversion cannot be done at compile-time.
+ */
+static bool convertValue(FoldedValue &value, ast::BuiltinType *from, ast::BuiltinType *to) {
+    if (from->isBooleanType() || to->isBooleanType()) return false;
+
+    if (from->isIntegerType() && to->isIntegerType()) {
+        value.integer = value.integer.extOrTrunc(getBitWidth(to));
+        value.integer.setIsUnsigned(to->isUnsignedIntegerType());
+        return true;
+    }
+
+    if (from->isIntegerType() && to->isFloatingPointType()) {
+        value.floating = llvm::APFloat(getSemantics(to));
+        value.floating.convertFromAPInt(value.integer, value.integer.isSigned(), llvm::APFloat::rmNearestTiesToEven);
+        value.isFloatingPoint = true;
+        return true;
+    }
+
+    if (from->isFloatingPointType() && to->isIntegerType()) {
+        llvm::APSInt result(getBitWidth(to), to->isUnsignedIntegerType());
+        bool isExact;
+        if (value.floating.convertToInteger(result, llvm::APFloat::rmTowardZero, &isExact) & llvm::APFloat::opInvalidOp)
+            return false; // out of range, this would be a poison value.
+
+        value.integer = result;
+        value.isFloatingPoint = false;
+        return true;
+    }
+
+    if (from->isFloatingPointType() && to->isFloatingPointType()) {
+        bool losesInfo;
+        value.floating.convert(getSemantics(to), llvm::APFloat::rmNearestTiesToEven, &losesInfo);
+        return true;
+    }
+
+    return false;
+}
+
+static bool foldIntegerOperation(lexer::token_ty oper, const llvm::APSInt &L, const llvm::APSInt &R, FoldedValue &result) {
+    unsigned width = L.getBitWidth();
+
+    switch (oper) {
+        case lexer::TokenOperatorPlus:
+            result.integer = L + R;
+            return true;
+        case lexer::TokenOperatorMinus:
+            result.integer = L - R;
+            return true;
+        case lexer::TokenOperatorMultiply:
+            result.integer = L * R;
+            return true;
+        case lexer::TokenOperatorDivide:
+        case lexer::TokenOperatorRemainder:
+            if (!R) return false;
+            if (L.isSigned() && L.isMinSignedValue() && R.isAllOnesValue()) return false;
+
+            result.integer = oper == lexer::TokenOperatorDivide ? L / R : L % R;
+            return true;
+
+        case lexer::TokenOperatorLeftShift:
+        case lexer::TokenOperatorRightShift:
+            if (R.isNegative() || R.getLimitedValue() >= width) return false;
+
+            if (oper == lexer::TokenOperatorLeftShift) result.integer = L << (unsigned)R.getLimitedValue();
+            else result.integer = L >> (unsigned)R.getLimitedValue(); // arithmetic shift for signed values, as the IR builder does.
+            return true;
+        case lexer::TokenOperatorBitwiseAnd:
+            result.integer = L & R;
+            return true;
+        case lexer::TokenOperatorBitwiseOr:
+            result.integer = L | R;
+            return true;
+    }
+
+    bool comparison;
+    switch (oper) {
+        case lexer::TokenOperatorLower:         comparison = L < R; break;
+        case lexer::TokenOperatorLowerEqual:    comparison = L <= R; break;
+        case lexer::TokenOperatorGreater:       comparison = L > R; break;
+        case lexer::TokenOperatorGreaterEqual:  comparison = L >= R; break;
+        case lexer::TokenOperatorEqual:         comparison = L == R; break;
+        case lexer::TokenOperatorNotEqual:      comparison = L != R; break;
+        default: return false;
+    }
+
+    result.integer = llvm::APSInt(llvm::APInt(1, comparison ? 1 : 0), /*isUnsigned=*/true);
+    return true;
+}
+
+static bool foldFloatingPointOperation(lexer::token_ty oper, const llvm::APFloat &L, const llvm::APFloat &R, FoldedValue &result) {
+    result.isFloatingPoint = true;
+    result.floating = L;
+
+    switch (oper) {
+        case lexer::TokenOperatorPlus:
+            result.floating.add(R, llvm::APFloat::rmNearestTiesToEven);
+            return true;
+        case lexer::TokenOperatorMinus:
+            result.floating.subtract(R, llvm::APFloat::rmNearestTiesToEven);
+            return true;
+        case lexer::TokenOperatorMultiply:
+            result.floating.multiply(R, llvm::APFloat::rmNearestTiesToEven);
+            return true;
+        case lexer::TokenOperatorDivide:
+            result.floating.divide(R, llvm::APFloat::rmNearestTiesToEven);
+            return true;
+        case lexer::TokenOperatorRemainder:
+            result.floating.mod(R);
+            return true;
+    }
+
+    llvm::APFloat::cmpResult cmp = L.compare(R);
+
+    bool comparison;
+    switch (oper) { // ordered comparisons, any comparison with a NaN is false.
+        case lexer::TokenOperatorLower:         comparison = cmp == llvm::APFloat::cmpLessThan; break;
+        case lexer::TokenOperatorLowerEqual:    comparison = cmp == llvm::APFloat::cmpLessThan || cmp == llvm::APFloat::cmpEqual; break;
+        case lexer::TokenOperatorGreater:       comparison = cmp == llvm::APFloat::cmpGreaterThan; break;
+        case lexer::TokenOperatorGreaterEqual:  comparison = cmp == llvm::APFloat::cmpGreaterThan || cmp == llvm::APFloat::cmpEqual; break;
+        case lexer::TokenOperatorEqual:         comparison = cmp == llvm::APFloat::cmpEqual; break;
+        case lexer::TokenOperatorNotEqual:      comparison = cmp == llvm::APFloat::cmpLessThan || cmp == llvm::APFloat::cmpGreaterThan; break;
+        default: return false;
+    }
+
+    result.isFloatingPoint = false;
+    result.integer = llvm::APSInt(llvm::APInt(1, comparison ? 1 : 0), /*isUnsigned=*/true);
+    return true;
+}
+
+/*!
+ \brief Returns whether \c expression only reads a variable or one of its fields, so that skipping its evaluation changes nothing.
+ */
+static bool isPlainReference(ast::Expr *expression) {
+    if (llvm::isa<ast::VarRef>(expression)) return true;
+    if (ast::FieldRef *fieldRef = llvm::dyn_cast<ast::FieldRef>(expression)) return isPlainReference(fieldRef->getEntity());
+    return false;
+}
+
+/*!
+ \brief Returns whether the cast chain \c source -> \c middle -> \c destination gives the same value as the single cast \c source -> \c destination.
+ */
+static bool canMergeCasts(ast::Type *source, ast::Type *middle, ast::Type *destination) {
+    ast::BuiltinType *srcTy = getFoldableType(source);
+    ast::BuiltinType *midTy = getFoldableType(middle);
+    ast::BuiltinType *dstTy = getFoldableType(destination);
+
+    if (!srcTy || !midTy || !dstTy) return false;
+
+    if (srcTy->isIntegerType() && midTy->isIntegerType() && dstTy->isIntegerType()) {
+        if (getBitWidth(midTy) < getBitWidth(srcTy)) return false; // the first cast truncates the value.
+
+        // a second extension would use the signedness of the middle type.
+        return getBitWidth(dstTy) <= getBitWidth(midTy) || midTy->isSignedIntegerType() == srcTy->isSignedIntegerType();
+    }
+
+    if (srcTy->isFloatingPointType() && midTy->isFloatingPointType() && dstTy->isFloatingPointType()) {
+        return midTy->getMagnitude() >= srcTy->getMagnitude();
+    }
+
+    return false;
+}
+
+
+ast::Expr *simplifier::ASTSimplifier::simplify(ast::Expr *expression) {
+    if (!expression) return nullptr;
+
+    simplified = expression;
+    takeStmt(expression);
+    return simplified;
+}
+
+void simplifier::ASTSimplifier::simplifyAST(ast::AbstractSyntaxTree *ast) {
+    assert(ast && "No AST has been passed to the simplifier.");
+
+    takeDecl(ast->getRootNameSpace());
+}
+
+void simplifier::ASTSimplifier::visitNameSpaceDecl(ast::NameSpaceDecl *nameSpace) {
+    for (ast::Decl *decl : nameSpace->getDeclarations())
+        takeDecl(decl);
+}
+
+void simplifier::ASTSimplifier::visitGlobalVar(ast::GlobalVar *var) {
+    if (ast::Expr *initVal = var->getInitialValue())
+        var->setInitialValue(simplify(initVal));
+}
+
+void simplifier::ASTSimplifier::visitFunctionDecl(ast::FunctionDecl *function) {
+    scan(function->getStatementsBlock());
+}
+
+void simplifier::ASTSimplifier::visitClassDecl(ast::ClassDecl *classDecl) {
+    for (ast::FieldDecl *field : classDecl->getFields())
+        visitGlobalVar(field);
+}
+
+void simplifier::ASTSimplifier::visitCompoundStmt(ast::CompoundStmt *statement) {
+    for (ast::Stmt *stmt : statement->statements())
+        scan(stmt);
+}
+
+void simplifier::ASTSimplifier::visitVarDeclStmt(ast::VarDeclStmt *statement) {
+    for (ast::Var *var : statement->getDeclaredVariables()) {
+        if (ast::LocalVar *localVar = llvm::dyn_cast<ast::LocalVar>(var)) {
+            if (ast::Expr *initVal = localVar->getInitialValue())
+                localVar->setInitialValue(simplify(initVal));
+        }
+    }
+}
+
+void simplifier::ASTSimplifier::visitReturnStmt(ast::ReturnStmt *statement) {
+    if (ast::Expr *returnVal = statement->getReturnValue())
+        statement->setReturnValue(simplify(returnVal));
+}
+
+void simplifier::ASTSimplifier::visitIfStmt(ast::IfStmt *statement) {
+    statement->setCondition(simplify(statement->getCondition()));
+    scan(statement->getThenBlock());
+    scan(statement->getElseBlock());
+}
+
+void simplifier::ASTSimplifier::visitSwitchStmt(ast::SwitchStmt *statement) {
+    statement->setSelectionValue(simplify(statement->getSelectionValue()));
+    scan(statement->getBlock());
+}
+
+void simplifier::ASTSimplifier::visitCaseStmt(ast::CaseStmt *statement) {
+    const std::vector<ast::Expr *> &values = statement->getValues();
+    for (unsigned i = 0; i < values.size(); i++)
+        statement->setValue(i, simplify(values[i]));
+}
+
+void simplifier::ASTSimplifier::visitSimpleIterStmt(ast::SimpleIterStmt *statement) {
+    statement->setCondition(simplify(statement->getCondition()));
+    scan(statement->getBlock());
+}
+
+void simplifier::ASTSimplifier::visitForStmt(ast::ForStmt *statement) {
+    for (ast::Stmt *stmt : statement->getInitStatements()) scan(stmt);
+    for (ast::Stmt *stmt : statement->getEndStatements()) scan(stmt);
+
+    visitSimpleIterStmt(statement);
+}
+
+void simplifier::ASTSimplifier::visitExpr(ast::Expr *expression) {
+    simplified = expression;
+}
+
+void simplifier::ASTSimplifier::visitImplicitCastExpr(ast::ImplicitCastExpr *cast) {
+    cast->setExpression(simplify(cast->getExpression()));
+    simplified = cast;
+
+    while (ast::ImplicitCastExpr *inner = llvm::dyn_cast<ast::ImplicitCastExpr>(cast->getExpression())) {
+        if (!canMergeCasts(inner->getExpression()->evalType(), inner->getDestination(), cast->getDestination())) break;
+
+        cast->setExpression(inner->getExpression());
+    }
+
+    ast::Expr *val = cast->getExpression();
+    ast::Type *original = val->evalType();
+    ast::Type *destination = cast->getDestination();
+
+    if (!original || !destination) return;
+
+    if (original->getCanonicalType() == destination->getCanonicalType()) { // identity cast.
+        simplified = val;
+        return;
+    }
+
+    ast::BuiltinType *originalTy = getFoldableType(original);
+    ast::BuiltinType *destinationTy = getFoldableType(destination);
+
+    FoldedValue value;
+    if (originalTy && destinationTy && getLiteralValue(val, value) && convertValue(value, originalTy, destinationTy)) {
+        simplified = replaceWith(cast, createLiteral(destinationTy, value));
+    }
+}
+
+void simplifier::ASTSimplifier::visitEvalExpr(ast::EvalExpr *eval) {
+    eval->setExpression(simplify(eval->getExpression()));
+    simplified = eval;
+
+    ast::Expr *val = eval->getExpression();
+    ast::BuiltinType *valTy = getFoldableType(val->evalType());
+
+    FoldedValue value;
+    if (!valTy || valTy->isFloatingPointType() || !getLiteralValue(val, value)) return;
+
+    simplified = replaceWith(eval, new ast::BoolLiteral(value.integer.getBoolValue()));
+}
+
+void simplifier::ASTSimplifier::visitBinaryExpr(ast::BinaryExpr *expression) {
+    expression->setLHS(simplify(expression->getLHS()));
+    expression->setRHS(simplify(expression->getRHS()));
+    simplified = expression;
+
+    ast::BuiltinType *operandTy = getFoldableType(expression->getLHS()->evalType());
+    ast::BuiltinType *resultTy = getFoldableType(expression->evalType());
+
+    if (!operandTy || !resultTy || operandTy->isBooleanType()) return;
+    if (operandTy != getFoldableType(expression->getRHS()->evalType())) return;
+    if (!llvm::isa<ast::ComparisonExpr>(expression) && resultTy != operandTy) return;
+
+    FoldedValue L, R, result;
+    if (!getLiteralValue(expression->getLHS(), L) || !getLiteralValue(expression->getRHS(), R)) return;
+
+    bool folded;
+    if (operandTy->isFloatingPointType()) {
+        folded = llvm::isa<ast::BitwiseExpr>(expression) ? false : foldFloatingPointOperation(expression->getOperator(), L.floating, R.floating, result);
+    } else {
+        folded = foldIntegerOperation(expression->getOperator(), L.integer, R.integer, result);
+    }
+
+    if (folded) simplified = replaceWith(expression, createLiteral(resultTy, result));
+}
+
+void simplifier::ASTSimplifier::visitAssignmentExpr(ast::AssignmentExpr *expression) {
+    scan(expression->getLHS()); // the left-hand side must stay assignable.
+    expression->setRHS(simplify(expression->getRHS()));
+
+    simplified = expression;
+}
+
+void simplifier::ASTSimplifier::visitArithmeticNegationExpr(ast::ArithmeticNegationExpr *expression) {
+    expression->setOperand(simplify(expression->getOperand()));
+    simplified = expression;
+
+    ast::BuiltinType *operandTy = getFoldableType(expression->getOperand()->evalType());
+
+    FoldedValue value;
+    if (!operandTy || operandTy->isBooleanType() || !getLiteralValue(expression->getOperand(), value)) return;
+
+    if (value.isFloatingPoint) value.floating.changeSign();
+    else value.integer = -value.integer;
+
+    simplified = replaceWith(expression, createLiteral(operandTy, value));
+}
+
+void simplifier::ASTSimplifier::visitLogicalNegationExpr(ast::LogicalNegationExpr *expression) {
+    expression->setOperand(simplify(expression->getOperand()));
+    simplified = expression;
+
+    if (ast::BoolLiteral *literal = llvm::dyn_cast<ast::BoolLiteral>(expression->getOperand())) {
+        simplified = replaceWith(expression, new ast::BoolLiteral(!literal->getValue()));
+    }
+}
+
+void simplifier::ASTSimplifier::visitBitwiseNegationExpr(ast::BitwiseNegationExpr *expression) {
+    expression->setOperand(simplify(expression->getOperand()));
+    simplified = expression;
+
+    ast::BuiltinType *operandTy = getFoldableType(expression->getOperand()->evalType());
+
+    FoldedValue value;
+    if (!operandTy || !operandTy->isIntegerType() || !getLiteralValue(expression->getOperand(), value)) return;
+
+    value.integer = ~value.integer;
+    simplified = replaceWith(expression, createLiteral(operandTy, value));
+}
+
+void simplifier::ASTSimplifier::visitFunctionCall(ast::FunctionCall *functionCall) {
+    const std::vector<ast::Expr *> &actualParams = functionCall->getActualParams();
+
+    for (unsigned i = 0; i < actualParams.size(); i++) {
+        functionCall->setActualParam(i, simplify(actualParams[i]));
+    }
+
+    simplified = functionCall;
+}
+
+void simplifier::ASTSimplifier::visitFieldRef(ast::FieldRef *fieldRef) {
+    fieldRef->setEntity(simplify(fieldRef->getEntity()));
+    simplified = fieldRef;
+}
+
+void simplifier::ASTSimplifier::visitSubscriptExpr(ast::SubscriptExpr *subscript) {
+    subscript->setEntity(simplify(subscript->getEntity()));
+    subscript->setIndex(simplify(subscript->getIndex()));
+    simplified = subscript;
+}
+
+void simplifier::ASTSimplifier::visitLengthExpr(ast::LengthExpr *length) {
+    length->setEntity(simplify(length->getEntity()));
+    simplified = length;
+
+    // the length of an array is known at compile-time.
+    ast::ArrayType *arrayType = llvm::dyn_cast<ast::ArrayType>(length->getEntity()->evalType()->getCanonicalType());
+    if (arrayType && isPlainReference(length->getEntity())) {
+        simplified = replaceWith(length, new ast::LongLiteral((runtime::int64_ty)arrayType->getLength()));
+    }
+}
+
+void simplifier::ASTSimplifier::visitShuffleExpr(ast::ShuffleExpr *shuffle) {
+    const std::vector<ast::Expr *> &arguments = shuffle->getArguments();
+
+    for (unsigned i = 0; i < arguments.size(); i++) {
+        shuffle->setArgument(i, simplify(arguments[i]));
+    }
+
+    simplified = shuffle;
+}
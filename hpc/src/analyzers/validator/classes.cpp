@@ -8,12 +8,62 @@
 //
 
 #include <hpc/analyzers/validator/validator.h>
+#include <hpc/ir/builders.h>
 #include <hpc/diagnostics/diagnostics.h>
 #include <hpc/ast/decls/class.h>
 #include <hpc/ast/decls/protocol.h>
 
+#include <llvm/IR/Value.h>
+#include <llvm/Support/MathExtras.h>
+
+#include <algorithm>
+
 using namespace hpc;
 
+/*!
+ \brief Returns the alignment in bytes the fields of the given class need on the target, as laid out by \c builder.
+ */
+static unsigned getNaturalAlignment(ast::ClassDecl *classDecl, codegen::ModuleBuilder &builder) {
+    if (classDecl->isPacked()) return 1;
+    
+    unsigned alignment = 1;
+    for (ast::FieldDecl *field : classDecl->getFields()) {
+        alignment = std::max(alignment, builder.getAlignment(field->getType()));
+    }
+    return alignment;
+}
+
+
+void validator::ValidatorImpl::checkClassAttributes(ast::ClassDecl *classDecl) {
+    unsigned alignment = classDecl->getRequestedAlignment();
+    unsigned padding = classDecl->getRequestedPadding();
+    
+    if (alignment && !llvm::isPowerOf2_32(alignment)) {
+        validator.getDiags().reportError(diag::ClassAttributeNotPowerOfTwo, classDecl->tokenRef(ast::PointToVariableIdentifier))
+            << "aligned to" << alignment << classDecl->getName();
+        classDecl->resignValidation();
+    } else if (alignment > llvm::Value::MaximumAlignment) {
+        validator.getDiags().reportError(diag::ClassAlignmentTooLarge, classDecl->tokenRef(ast::PointToVariableIdentifier))
+            << alignment << classDecl->getName() << (unsigned)llvm::Value::MaximumAlignment;
+        classDecl->resignValidation();
+    }
+    
+    if (padding && !llvm::isPowerOf2_32(padding)) {
+        validator.getDiags().reportError(diag::ClassAttributeNotPowerOfTwo, classDecl->tokenRef(ast::PointToVariableIdentifier))
+            << "padded to" << padding << classDecl->getName();
+        classDecl->resignValidation();
+    }
+    
+    target::TargetInfo *targetInfo = validator.getTargetInfo();
+    if (!targetInfo || !alignment || !classDecl->isValid()) return;
+    
+    unsigned naturalAlignment = getNaturalAlignment(classDecl, validator.getLayoutBuilder());
+    if (alignment < naturalAlignment) {
+        validator.getDiags().reportWarning(diag::ClassAlignmentBelowNatural, classDecl->tokenRef(ast::PointToVariableIdentifier))
+            << alignment << classDecl->getName() << naturalAlignment;
+    }
+}
+
 void validator::ValidatorImpl::visitClassDecl(ast::ClassDecl *classDecl) {
     visitNameSpaceDecl(classDecl);
     
@@ -35,6 +85,8 @@ void validator::ValidatorImpl::visitClassDecl(ast::ClassDecl *classDecl) {
             classDecl->resignValidation();
         }
     }
+    
+    checkClassAttributes(classDecl);
 }
 
 void validator::ValidatorImpl::visitProtocolDecl(ast::ProtocolDecl *protocolDecl) {
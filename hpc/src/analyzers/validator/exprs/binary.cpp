@@ -71,6 +71,7 @@ void validator::ValidatorImpl::visitAssignmentExpr(ast::AssignmentExpr *expressi
     } else if (lhsTy->isPointerType() && rhs->isNullPointer()) {
         rhs = new ast::NullPointer(lhsTy);
     } else if (rhsTy->canAssignTo(lhsTy)) {
+        checkStackSlice(rhs, lhsTy);
         expression->castRHSToType(lhsTy);
         //validate(rhs);
         
@@ -83,8 +84,14 @@ void validator::ValidatorImpl::visitAssignmentExpr(ast::AssignmentExpr *expressi
 
 void validator::ValidatorImpl::visitBitwiseExpr(ast::BitwiseExpr *expression) {
     visitBinaryExpr(expression);
+    if (!expression->isValid()) return;
     
-    if (expression->isValid() && !expression->evalType()->isIntegerType()) {
+    // masks produced by vector comparisons can be combined with '&' and '|'.
+    ast::Type *scalarType = expression->evalType()->getScalarType();
+    bool combinesMasks = expression->evalType()->isVectorType() && scalarType->isBooleanType() &&
+                         (expression->getOperator() == lexer::TokenOperatorBitwiseAnd || expression->getOperator() == lexer::TokenOperatorBitwiseOr);
+    
+    if (!scalarType->isIntegerType() && !combinesMasks) {
         validator.getDiags().reportError(diag::IncompatibleTypesInBinary, expression->tokenRef(ast::PointToOperator))
             << expression->getLHS()->evalType()->asString() << expression->getRHS()->evalType()->asString();
         expression->resignValidation();
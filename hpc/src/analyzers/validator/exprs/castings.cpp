@@ -11,10 +11,34 @@
 #include <hpc/diagnostics/diagnostics.h>
 #include <hpc/ast/exprs/castings.h>
 #include <hpc/ast/exprs/constant.h>
+#include <hpc/ast/exprs/reference.h>
+#include <hpc/ast/exprs/members.h>
+#include <hpc/ast/decls/function.h>
 #include <hpc/config.h>
 
 using namespace hpc;
 
+void validator::ValidatorImpl::checkStackSlice(ast::Expr *value, ast::Type *destination) {
+    if (!getResolver().hasLocalStack()) return; // the initializers of global variables have no stack frame.
+    if (!value->evalType()->getCanonicalType()->isArrayType() || !destination->isSliceType()) return;
+    
+    // finds where the array is stored: the elements of a slice have been stored by the code making the slice.
+    ast::Expr *entity = value;
+    while (true) {
+        if (ast::FieldRef *fieldRef = llvm::dyn_cast<ast::FieldRef>(entity)) {
+            entity = fieldRef->getEntity();
+        } else if (ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(entity)) {
+            if (subscript->getEntity()->evalType()->isSliceType()) return;
+            entity = subscript->getEntity();
+        } else break;
+    }
+    
+    ast::VarRef *varRef = llvm::dyn_cast<ast::VarRef>(entity);
+    if (varRef && llvm::isa<ast::GlobalVar>(varRef->getVar())) return;
+    
+    getResolver().getInnermostStack().getFunction()->setSlicesStack(true);
+}
+
 void validator::ValidatorImpl::visitImplicitCastExpr(ast::ImplicitCastExpr *cast) {
     if (!cast->getExpression()->evalType()->canCastTo(cast->getDestination())) {
         cast->resignValidation();
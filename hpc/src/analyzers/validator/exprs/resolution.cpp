@@ -107,6 +107,7 @@ void validator::ValidatorImpl::visitFunctionCall(ast::FunctionCall *functionCall
             int i = 0;
             ast::FunctionDecl *thePrototype = candidateFunctions.front();
             for (ast::ParamVar *argument : thePrototype->getArgs()) {
+                checkStackSlice(functionCall->getActualParams()[i], argument->getType());
                 functionCall->castActualParamToType(i++, argument->getType());
             }
             functionCall->setFunctionDecl(thePrototype);
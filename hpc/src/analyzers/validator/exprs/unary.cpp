@@ -18,7 +18,7 @@ void validator::ValidatorImpl::visitArithmeticNegationExpr(ast::ArithmeticNegati
     if (validate(expression->getOperand())) {
         ast::Type *operandTy = expression->getOperand()->evalType();
         
-        if (!operandTy->isNumericType()) {
+        if (!operandTy->getScalarType()->isNumericType()) {
             validator.getDiags().reportError(diag::InvalidExpressionToUnaryOperation, expression->tokenRef(ast::PointToOperator)) << operandTy->asString();
             expression->resignValidation();
         }
@@ -39,7 +39,7 @@ void validator::ValidatorImpl::visitBitwiseNegationExpr(ast::BitwiseNegationExpr
     if (validate(expression->getOperand())) {
         ast::Type *operandTy = expression->getOperand()->evalType();
         
-        if (!operandTy->isIntegerType()) {
+        if (!operandTy->getScalarType()->isIntegerType()) {
             validator.getDiags().reportError(diag::InvalidExpressionToUnaryOperation, expression->tokenRef(ast::PointToOperator)) << operandTy->asString();
             expression->resignValidation();
         }
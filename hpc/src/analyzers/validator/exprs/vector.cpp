@@ -0,0 +1,143 @@
+// => src/analyzers/validator/exprs/vector.cpp
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#include <hpc/analyzers/validator/validator.h>
+#include <hpc/diagnostics/diagnostics.h>
+#include <hpc/ast/types/vectortype.h>
+#include <hpc/ast/types/arraytype.h>
+#include <hpc/ast/exprs/constant.h>
+#include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/shuffle.h>
+
+using namespace hpc;
+
+/*!
+ \brief Returns the vector type of \c expression, or \c nullptr if \c expression is not a vector.
+ */
+static ast::VectorType *getVectorType(ast::Expr *expression) {
+    return llvm::dyn_cast<ast::VectorType>(expression->evalType()->getCanonicalType());
+}
+
+void validator::ValidatorImpl::visitSubscriptExpr(ast::SubscriptExpr *subscript) {
+    bool entityValid = validate(subscript->getEntity());
+    bool indexValid = validate(subscript->getIndex());
+    
+    if (!entityValid || !indexValid) {
+        subscript->resignValidation();
+        return;
+    }
+    
+    ast::Type *entityTy = subscript->getEntity()->evalType();
+    if (!entityTy->isVectorType() && !entityTy->isArrayType() && !entityTy->isSliceType()) {
+        validator.getDiags().reportError(diag::SubscriptOfInvalidType, subscript->tokenRef(ast::PointToOperator))
+            << entityTy->asString();
+        subscript->resignValidation();
+        return;
+    }
+    
+    ast::Expr *index = subscript->getIndex();
+    if (!index->evalType()->isIntegerType()) {
+        validator.getDiags().reportError(diag::IndexNotInteger, index->completeRef()) << index->evalType()->asString();
+        subscript->resignValidation();
+        return;
+    }
+    
+    // constant indices are checked here, so that they need no check at run-time.
+    ast::IntegerLiteral *literal = llvm::dyn_cast<ast::IntegerLiteral>(index);
+    if (!literal) return;
+    
+    if (ast::VectorType *vectorType = getVectorType(subscript->getEntity())) {
+        if (literal->getValue() < 0 || (unsigned)literal->getValue() >= vectorType->getNumLanes()) {
+            validator.getDiags().reportError(diag::LaneIndexOutOfRange, index->completeRef())
+                << literal->getValue() << vectorType->getNumLanes();
+            subscript->resignValidation();
+        }
+    } else if (ast::ArrayType *arrayType = llvm::dyn_cast<ast::ArrayType>(entityTy->getCanonicalType())) {
+        if (literal->getValue() < 0 || (uint64_t)literal->getValue() >= arrayType->getLength()) {
+            validator.getDiags().reportError(diag::ArrayIndexOutOfBounds, index->completeRef())
+                << literal->getValue() << arrayType->getLength();
+            subscript->resignValidation();
+        }
+    }
+}
+
+void validator::ValidatorImpl::visitLengthExpr(ast::LengthExpr *length) {
+    if (!validate(length->getEntity())) {
+        length->resignValidation();
+        return;
+    }
+    
+    ast::Type *entityTy = length->getEntity()->evalType();
+    if (!entityTy->isArrayType() && !entityTy->isSliceType()) {
+        validator.getDiags().reportError(diag::LengthOfInvalidType, length->getEntity()->completeRef()) << entityTy->asString();
+        length->resignValidation();
+    }
+}
+
+void validator::ValidatorImpl::visitShuffleExpr(ast::ShuffleExpr *shuffle) {
+    const std::vector<ast::Expr *> &arguments = shuffle->getArguments();
+    
+    for (ast::Expr *argument : arguments) {
+        if (!validate(argument)) shuffle->resignValidation();
+    }
+    
+    if (!shuffle->isValid()) return;
+    
+    if (arguments.empty() || !getVectorType(arguments[0])) {
+        validator.getDiags().reportError(diag::ShuffleOperandNotVector, arguments.empty() ? shuffle->tokenRef(ast::PointToBeginOfExpression) : arguments[0]->completeRef())
+            << (arguments.empty() ? "void" : arguments[0]->evalType()->asString());
+        shuffle->resignValidation();
+        return;
+    }
+    
+    ast::VectorType *vectorType = getVectorType(arguments[0]);
+    
+    unsigned numVectors = 1;
+    if (arguments.size() > 1 && getVectorType(arguments[1])) {
+        if (!ast::Type::areEquivalent(arguments[0]->evalType(), arguments[1]->evalType())) {
+            validator.getDiags().reportError(diag::ShuffledVectorsMismatch, arguments[1]->completeRef())
+                << arguments[0]->evalType()->asString() << arguments[1]->evalType()->asString();
+            shuffle->resignValidation();
+            return;
+        }
+        numVectors = 2;
+    }
+    
+    // the lanes of the second vector follow the ones of the first vector.
+    unsigned availableLanes = numVectors * vectorType->getNumLanes();
+    
+    std::vector<unsigned> mask;
+    for (unsigned i = numVectors; i < arguments.size(); i++) {
+        ast::IntegerLiteral *literal = llvm::dyn_cast<ast::IntegerLiteral>(arguments[i]);
+        if (!literal) {
+            validator.getDiags().reportError(diag::ShuffleIndexNotConstant, arguments[i]->completeRef());
+            shuffle->resignValidation();
+            continue;
+        }
+        
+        if (literal->getValue() < 0 || (unsigned)literal->getValue() >= availableLanes) {
+            validator.getDiags().reportError(diag::LaneIndexOutOfRange, arguments[i]->completeRef())
+                << literal->getValue() << availableLanes;
+            shuffle->resignValidation();
+            continue;
+        }
+        
+        mask.push_back(literal->getValue());
+    }
+    
+    if (!shuffle->isValid()) return;
+    
+    if (mask.empty()) {
+        validator.getDiags().reportError(diag::ShuffleIndexNotConstant, shuffle->tokenRef(ast::PointToEndOfExpression));
+        shuffle->resignValidation();
+        return;
+    }
+    
+    shuffle->setShuffle(numVectors, mask, ast::VectorType::get(vectorType->getElementType(), mask.size()));
+}
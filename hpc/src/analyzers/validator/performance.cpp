@@ -0,0 +1,259 @@
+// => src/analyzers/validator/performance.cpp
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#include <hpc/analyzers/validator/performance.h>
+#include <hpc/ast/unit.h>
+#include <hpc/ast/decls/namespace.h>
+#include <hpc/ast/decls/variable.h>
+#include <hpc/ast/decls/function.h>
+#include <hpc/ast/types/builtintype.h>
+#include <hpc/ast/types/compoundtype.h>
+#include <hpc/ast/stmt/statement.h>
+#include <hpc/ast/stmt/ifelse.h>
+#include <hpc/ast/stmt/switchselect.h>
+#include <hpc/ast/stmt/whileuntil.h>
+#include <hpc/ast/stmt/for.h>
+#include <hpc/ast/exprs/binary.h>
+#include <hpc/ast/exprs/unary.h>
+#include <hpc/ast/exprs/castings.h>
+#include <hpc/ast/exprs/constant.h>
+#include <hpc/ast/exprs/reference.h>
+#include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/shuffle.h>
+
+using namespace hpc;
+
+/*!
+ \brief Returns a token ref spanning the whole given expression, or pointing to its first token if the whole range is unknown.
+ */
+static source::TokenRef *getExpressionRange(ast::Expr *expression) {
+    if (!expression->tokenRef(ast::PointToBeginOfExpression)) return nullptr;
+    if (!expression->tokenRef(ast::PointToEndOfExpression)) return expression->tokenRef(ast::PointToBeginOfExpression);
+
+    return expression->completeRef();
+}
+
+/*!
+ \brief Returns the variable written by an assignment to \c expression, if known.
+ */
+static ast::Var *getAssignedVar(ast::Expr *expression) {
+    if (ast::VarRef *varRef = llvm::dyn_cast<ast::VarRef>(expression)) return varRef->getVar();
+    if (ast::FieldRef *fieldRef = llvm::dyn_cast<ast::FieldRef>(expression)) return getAssignedVar(fieldRef->getEntity());
+    if (ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(expression)) return getAssignedVar(subscript->getEntity());
+    return nullptr;
+}
+
+/*!
+ \brief Returns whether the implicit cast from \c original to \c destination widens a number to a larger type of the same kind.
+ */
+static bool isWideningCast(ast::Type *original, ast::Type *destination) {
+    ast::BuiltinType *originalTy = llvm::dyn_cast<ast::BuiltinType>(original->getCanonicalType());
+    ast::BuiltinType *destinationTy = llvm::dyn_cast<ast::BuiltinType>(destination->getCanonicalType());
+
+    if (!originalTy || !destinationTy) return false;
+
+    if ((originalTy->isIntegerType() && destinationTy->isIntegerType()) ||
+        (originalTy->isFloatingPointType() && destinationTy->isFloatingPointType()))
+        return destinationTy->getMagnitude() > originalTy->getMagnitude();
+
+    return false;
+}
+
+
+void validator::PerformanceLint::markVariant(ast::Var *var) {
+    if (!var) return;
+
+    for (LoopInfo &loop : loops) loop.variants.insert(var);
+}
+
+bool validator::PerformanceLint::isLoopInvariant(ast::Expr *expression, const LoopInfo &loop) {
+    if (llvm::isa<ast::Constant>(expression)) return true;
+
+    if (ast::VarRef *varRef = llvm::dyn_cast<ast::VarRef>(expression)) {
+        ast::Var *var = varRef->getVar();
+        // global variables and pointed memory may be changed by any call in the loop.
+        return var && !llvm::isa<ast::GlobalVar>(var) && !var->getType()->getCanonicalType()->isPointerType() && !loop.variants.count(var);
+    }
+
+    if (ast::ImplicitCastExpr *cast = llvm::dyn_cast<ast::ImplicitCastExpr>(expression))
+        return isLoopInvariant(cast->getExpression(), loop);
+    if (ast::EvalExpr *eval = llvm::dyn_cast<ast::EvalExpr>(expression))
+        return isLoopInvariant(eval->getExpression(), loop);
+    if (ast::FieldRef *fieldRef = llvm::dyn_cast<ast::FieldRef>(expression))
+        return isLoopInvariant(fieldRef->getEntity(), loop);
+    if (ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(expression)) // elements of slices may be changed by any call.
+        return !subscript->getEntity()->evalType()->isSliceType() && isLoopInvariant(subscript->getEntity(), loop) && isLoopInvariant(subscript->getIndex(), loop);
+    if (ast::LengthExpr *length = llvm::dyn_cast<ast::LengthExpr>(expression))
+        return isLoopInvariant(length->getEntity(), loop);
+    if (ast::BinaryExpr *binary = llvm::dyn_cast<ast::BinaryExpr>(expression))
+        return !llvm::isa<ast::AssignmentExpr>(binary) && isLoopInvariant(binary->getLHS(), loop) && isLoopInvariant(binary->getRHS(), loop);
+    if (ast::UnaryExpr *unary = llvm::dyn_cast<ast::UnaryExpr>(expression))
+        return isLoopInvariant(unary->getOperand(), loop);
+
+    return false;
+}
+
+void validator::PerformanceLint::lintLoop(ast::SimpleIterStmt *statement, const std::vector<ast::Stmt *> &endStatements) {
+    loops.push_back(LoopInfo());
+
+    bool wasInLoopCondition = inLoopCondition;
+    inLoopCondition = true;
+    scan(statement->getCondition());
+    inLoopCondition = false;
+
+    for (ast::Stmt *stmt : endStatements) scan(stmt);
+    scan(statement->getBlock());
+
+    inLoopCondition = wasInLoopCondition;
+
+    LoopInfo loop = loops.back();
+    loops.pop_back();
+
+    for (ast::FunctionCall *functionCall : loop.conditionCalls) {
+        const std::vector<ast::Expr *> &actualParams = functionCall->getActualParams();
+        if (actualParams.empty()) continue; // the function probably reads a state changed by the loop.
+
+        // a call with side effects, or depending on memory the loop may change, must be repeated on every iteration.
+        if (!purity.isReadNone(functionCall->getFunctionDecl())) continue;
+
+        bool invariant = true;
+        for (ast::Expr *param : actualParams) {
+            if (!isLoopInvariant(param, loop)) {
+                invariant = false;
+                break;
+            }
+        }
+
+        if (invariant) {
+            diags.reportWarning(diag::LoopInvariantCallInCondition, getExpressionRange(functionCall))
+                << functionCall->getFunctionDecl()->getName();
+        }
+    }
+}
+
+void validator::PerformanceLint::lintAST(ast::AbstractSyntaxTree *ast) {
+    assert(ast && "No AST has been passed to the performance lint.");
+
+    takeDecl(ast->getRootNameSpace());
+}
+
+void validator::PerformanceLint::visitNameSpaceDecl(ast::NameSpaceDecl *nameSpace) {
+    for (ast::Decl *decl : nameSpace->getDeclarations())
+        takeDecl(decl);
+}
+
+void validator::PerformanceLint::visitGlobalVar(ast::GlobalVar *var) {
+    ast::Expr *initVal = var->getInitialValue();
+
+    if (initVal && !var->hasConstantInitializer()) {
+        diags.reportWarning(diag::GlobalInitializerNotConstant, var->tokenRef(ast::PointToVariableIdentifier)) << var->getName();
+    }
+}
+
+void validator::PerformanceLint::visitFunctionDecl(ast::FunctionDecl *function) {
+    if (!function->getStatementsBlock()) return; // nothing is copied by a declaration.
+
+    for (ast::ParamVar *arg : function->getArgs()) {
+        if (llvm::isa<ast::ClassType>(arg->getType()->getCanonicalType())) {
+            diags.reportWarning(diag::ClassParameterPassedByValue, arg->tokenRef(ast::PointToVariableIdentifier))
+                << arg->getName() << arg->getType()->asString();
+        }
+    }
+
+    scan(function->getStatementsBlock());
+}
+
+void validator::PerformanceLint::visitCompoundStmt(ast::CompoundStmt *statement) {
+    for (ast::Stmt *stmt : statement->statements()) scan(stmt);
+}
+
+void validator::PerformanceLint::visitVarDeclStmt(ast::VarDeclStmt *statement) {
+    for (ast::Var *var : statement->getDeclaredVariables()) {
+        markVariant(var); // a variable declared in a loop gets a new value on every iteration.
+        scan(var->getInitialValue());
+    }
+}
+
+void validator::PerformanceLint::visitReturnStmt(ast::ReturnStmt *statement) {
+    scan(statement->getReturnValue());
+}
+
+void validator::PerformanceLint::visitIfStmt(ast::IfStmt *statement) {
+    scan(statement->getCondition());
+    scan(statement->getThenBlock());
+    scan(statement->getElseBlock());
+}
+
+void validator::PerformanceLint::visitSwitchStmt(ast::SwitchStmt *statement) {
+    scan(statement->getSelectionValue());
+    scan(statement->getBlock());
+}
+
+void validator::PerformanceLint::visitSimpleIterStmt(ast::SimpleIterStmt *statement) {
+    lintLoop(statement, std::vector<ast::Stmt *>());
+}
+
+void validator::PerformanceLint::visitForStmt(ast::ForStmt *statement) {
+    for (ast::Stmt *stmt : statement->getInitStatements()) scan(stmt);
+
+    lintLoop(statement, statement->getEndStatements());
+}
+
+void validator::PerformanceLint::visitImplicitCastExpr(ast::ImplicitCastExpr *cast) {
+    ast::Expr *val = cast->getExpression();
+
+    if (!loops.empty() && !llvm::isa<ast::Constant>(val) && val->evalType() && isWideningCast(val->evalType(), cast->getDestination())) {
+        diags.reportWarning(diag::ImplicitWideningCastInLoop, getExpressionRange(val))
+            << val->evalType()->asString() << cast->getDestination()->asString();
+    }
+
+    scan(val);
+}
+
+void validator::PerformanceLint::visitEvalExpr(ast::EvalExpr *cast) {
+    scan(cast->getExpression());
+}
+
+void validator::PerformanceLint::visitBinaryExpr(ast::BinaryExpr *expression) {
+    scan(expression->getLHS());
+    scan(expression->getRHS());
+}
+
+void validator::PerformanceLint::visitAssignmentExpr(ast::AssignmentExpr *expression) {
+    markVariant(getAssignedVar(expression->getLHS()));
+
+    visitBinaryExpr(expression);
+}
+
+void validator::PerformanceLint::visitUnaryExpr(ast::UnaryExpr *expression) {
+    scan(expression->getOperand());
+}
+
+void validator::PerformanceLint::visitFunctionCall(ast::FunctionCall *functionCall) {
+    if (inLoopCondition) loops.back().conditionCalls.push_back(functionCall);
+
+    for (ast::Expr *param : functionCall->getActualParams()) scan(param);
+}
+
+void validator::PerformanceLint::visitFieldRef(ast::FieldRef *fieldRef) {
+    scan(fieldRef->getEntity());
+}
+
+void validator::PerformanceLint::visitSubscriptExpr(ast::SubscriptExpr *subscript) {
+    scan(subscript->getEntity());
+    scan(subscript->getIndex());
+}
+
+void validator::PerformanceLint::visitLengthExpr(ast::LengthExpr *length) {
+    scan(length->getEntity());
+}
+
+void validator::PerformanceLint::visitShuffleExpr(ast::ShuffleExpr *shuffle) {
+    for (ast::Expr *argument : shuffle->getArguments()) scan(argument);
+}
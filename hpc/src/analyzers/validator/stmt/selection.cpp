@@ -8,10 +8,76 @@
 //
 
 #include <hpc/analyzers/validator/validator.h>
+#include <hpc/diagnostics/diagnostics.h>
 #include <hpc/ast/stmt/ifelse.h>
+#include <hpc/ast/stmt/switchselect.h>
+#include <hpc/ast/exprs/castings.h>
+#include <hpc/ast/exprs/constant.h>
+#include <hpc/ast/exprs/unary.h>
+#include <hpc/ast/types/builtintype.h>
+
+#include <llvm/ADT/APSInt.h>
+#include <llvm/ADT/SmallString.h>
+
+#include <set>
 
 using namespace hpc;
 
+/*!
+ \brief The width of the case values, which holds any negated literal and any value of the integer types exactly.
+ */
+static const unsigned CaseValueWidth = 129;
+
+/*!
+ \brief Stores into \c value the exact value of the given case label value, returning \c false if it is not an integer or character literal, possibly negated.
+ \note The labels already cast to the type of the selection value are looked through.
+ */
+static bool getCaseValue(ast::Expr *expression, llvm::APSInt &value) {
+    if (ast::ImplicitCastExpr *cast = llvm::dyn_cast<ast::ImplicitCastExpr>(expression)) return getCaseValue(cast->getExpression(), value);
+    
+    if (ast::ArithmeticNegationExpr *negation = llvm::dyn_cast<ast::ArithmeticNegationExpr>(expression)) {
+        if (!getCaseValue(negation->getOperand(), value)) return false;
+        
+        value = -value;
+        return true;
+    }
+    
+    llvm::APInt bits;
+    if (ast::CharLiteral *literal = llvm::dyn_cast<ast::CharLiteral>(expression)) bits = llvm::APInt(CaseValueWidth, (uint8_t)literal->getValue());
+    else if (ast::IntegerLiteral *literal = llvm::dyn_cast<ast::IntegerLiteral>(expression)) bits = llvm::APInt(CaseValueWidth, literal->getValue(), /*isSigned=*/true);
+    else if (ast::UIntegerLiteral *literal = llvm::dyn_cast<ast::UIntegerLiteral>(expression)) bits = llvm::APInt(CaseValueWidth, literal->getValue());
+    else if (ast::LongLiteral *literal = llvm::dyn_cast<ast::LongLiteral>(expression)) bits = llvm::APInt(CaseValueWidth, literal->getValue(), /*isSigned=*/true);
+    else if (ast::ULongLiteral *literal = llvm::dyn_cast<ast::ULongLiteral>(expression)) bits = llvm::APInt(CaseValueWidth, literal->getValue());
+    else return false;
+    
+    value = llvm::APSInt(bits, /*isUnsigned=*/false);
+    return true;
+}
+
+/*!
+ \brief Returns whether the given exact case value is a value of the integer type \c type, so that casting it keeps it unchanged.
+ */
+static bool isInRange(const llvm::APSInt &value, ast::Type *type) {
+    type = type->getCanonicalType();
+    if (ast::QualifiedType *qualType = llvm::dyn_cast<ast::QualifiedType>(type)) type = qualType->getEnclosingType()->getCanonicalType();
+    
+    unsigned width = llvm::cast<ast::BuiltinType>(type)->getMagnitude() * 8;
+    bool isUnsigned = type->isUnsignedIntegerType();
+    
+    llvm::APSInt min = llvm::APSInt::getMinValue(width, isUnsigned).extend(CaseValueWidth);
+    llvm::APSInt max = llvm::APSInt::getMaxValue(width, isUnsigned).extend(CaseValueWidth);
+    return value.sge(min) && value.sle(max);
+}
+
+/*!
+ \brief Returns the decimal representation of the given case value.
+ */
+static std::string getCaseValueString(const llvm::APSInt &value) {
+    llvm::SmallString<40> string;
+    value.toString(string, 10);
+    return std::string(string.str());
+}
+
 void validator::ValidatorImpl::visitIfStmt(ast::IfStmt *statement) {
     
     ast::Expr *condition = statement->getCondition();
@@ -27,3 +93,94 @@ void validator::ValidatorImpl::visitIfStmt(ast::IfStmt *statement) {
         statement->resignValidation();
     }
 }
+
+void validator::ValidatorImpl::visitSwitchStmt(ast::SwitchStmt *statement) {
+    ast::Expr *selectionVal = statement->getSelectionValue();
+    
+    if (!validate(selectionVal)) {
+        statement->resignValidation();
+        return;
+    }
+    
+    if (!selectionVal->evalType()->isIntegerType()) {
+        validator.getDiags().reportError(diag::SwitchValueNotInteger, selectionVal->completeRef()) << selectionVal->evalType()->asString();
+        statement->resignValidation();
+        return;
+    }
+    
+    LocalStack &stack = getResolver().getInnermostStack();
+    stack.pushBreakCatcher(statement);
+    stack.addScope();
+    
+    // the labels are only accepted as direct statements of the block, so that each one starts a block of the switch instruction.
+    std::set<llvm::APSInt> values;
+    for (ast::Stmt *stmt : statement->getBlock()->statements()) {
+        ast::CaseStmt *label = llvm::dyn_cast<ast::CaseStmt>(stmt);
+        if (label) stack.pushCaseCatcher(statement);
+        
+        if (!validate(stmt)) statement->resignValidation();
+        
+        if (!label) continue;
+        stack.popCaseCatcher();
+        
+        if (label->isDefault()) {
+            if (statement->hasDefaultCase()) {
+                validator.getDiags().reportError(diag::MultipleDefaultCases, label->tokenRef(ast::PointToStatementQualifier));
+                statement->resignValidation();
+            }
+            statement->setHasDefaultCase(true);
+            continue;
+        }
+        
+        // the values out of the range of the selection type have been reported by the label, so the values compared are never truncated.
+        for (ast::Expr *value : label->getValues()) {
+            llvm::APSInt caseValue;
+            if (getCaseValue(value, caseValue) && isInRange(caseValue, selectionVal->evalType()) && !values.insert(caseValue).second) {
+                validator.getDiags().reportError(diag::DuplicateCaseValue, value->completeRef()) << getCaseValueString(caseValue);
+                statement->resignValidation();
+            }
+        }
+    }
+    
+    stack.removeScope();
+    stack.popBreakCatcher();
+}
+
+void validator::ValidatorImpl::visitCaseStmt(ast::CaseStmt *statement) {
+    ast::SwitchStmt *container = llvm::dyn_cast_or_null<ast::SwitchStmt>(getResolver().getInnermostStack().getFirstCaseCatcher());
+    if (!container) {
+        validator.getDiags().reportError(diag::CaseNotInSwitch, statement->tokenRef(ast::PointToStatementQualifier));
+        statement->resignValidation();
+        return;
+    }
+    
+    statement->setSwitch(container);
+    
+    ast::Type *selectionType = container->getSelectionValue()->evalType();
+    const std::vector<ast::Expr *> &values = statement->getValues();
+    for (unsigned i = 0; i < values.size(); i++) {
+        if (!validate(values[i])) {
+            statement->resignValidation();
+            continue;
+        }
+        
+        llvm::APSInt caseValue;
+        if (!getCaseValue(values[i], caseValue)) {
+            validator.getDiags().reportError(diag::CaseValueNotConstant, values[i]->completeRef());
+            statement->resignValidation();
+            continue;
+        }
+        
+        if (!isInRange(caseValue, selectionType)) {
+            validator.getDiags().reportError(diag::CaseValueOutOfRange, values[i]->completeRef())
+                << getCaseValueString(caseValue) << selectionType->asString();
+            statement->resignValidation();
+            continue;
+        }
+        
+        // the values are simplified into constants of the selection type.
+        if (!ast::Type::areEquivalent(values[i]->evalType(), selectionType)) {
+            statement->setValue(i, new ast::ImplicitCastExpr(values[i], selectionType));
+        }
+    }
+}
@@ -10,7 +10,9 @@
 #include <hpc/analyzers/validator/validator.h>
 #include <hpc/diagnostics/diagnostics.h>
 #include <hpc/ast/exprs/castings.h>
+#include <hpc/ast/exprs/reference.h>
 #include <hpc/ast/stmt/statement.h>
+#include <hpc/ast/stmt/switchselect.h>
 
 using namespace hpc;
 
@@ -56,10 +58,39 @@ void validator::ValidatorImpl::visitReturnStmt(ast::ReturnStmt *statement) {
         return;
     }
     
+    if (statement->isTailCallRequired()) {
+        ast::FunctionCall *tailCall = llvm::dyn_cast<ast::FunctionCall>(returnVal);
+        if (!tailCall) {
+            validator.getDiags().reportError(diag::TailCallNotACall, statement->tokenRef(ast::PointToStatementQualifier));
+            statement->resignValidation();
+            return;
+        }
+        
+        // a guaranteed tail call reuses the frame of the caller, so both functions must take and return the same values.
+        ast::FunctionDecl *callee = tailCall->getFunctionDecl();
+        const std::vector<ast::ParamVar *> &calleeArgs = callee->getArgs();
+        const std::vector<ast::ParamVar *> &callerArgs = statement->getReceiver()->getArgs();
+        
+        bool compatible = ast::Type::areEquivalent(callee->getReturnType(), returnType) && calleeArgs.size() == callerArgs.size();
+        for (unsigned i = 0; compatible && i < calleeArgs.size(); i++) {
+            compatible = ast::Type::areEquivalent(calleeArgs[i]->getType(), callerArgs[i]->getType());
+        }
+        
+        if (!compatible) {
+            validator.getDiags().reportError(diag::TailCallSignatureMismatch, statement->tokenRef(ast::PointToStatementQualifier))
+                << callee->getName() << statement->getReceiver()->getName();
+            statement->resignValidation();
+            return;
+        }
+        
+        tailCalls.push_back(statement);
+    }
+    
     ast::Type *returnValTy = returnVal->evalType();
     
     if (!ast::Type::areEquivalent(returnValTy, returnType)) {
         if (returnValTy->canAssignTo(returnType)) {
+            checkStackSlice(returnVal, returnType);
             statement->castReturnValueToType(returnType);
         } else {
             validator.getDiags().reportError(diag::NoViableConversionInReturn, statement->tokenRef(ast::PointToStatementQualifier))
@@ -72,6 +103,9 @@ void validator::ValidatorImpl::visitReturnStmt(ast::ReturnStmt *statement) {
 void validator::ValidatorImpl::visitBreakStmt(ast::BreakStmt *statement) {
     if (ast::Stmt *catcher = getResolver().getInnermostStack().getFirstBreakCatcher()) {
         statement->setBreakCatcher(catcher);
+        
+        // a switch statement left by a break does not return on every path.
+        if (ast::SwitchStmt *switchStmt = llvm::dyn_cast<ast::SwitchStmt>(catcher)) switchStmt->setBroken(true);
     } else {
         validator.getDiags().reportError(diag::BreakNotInBreakableStatement, statement->tokenRef(ast::PointToStatementQualifier));
         statement->resignValidation();
@@ -40,10 +40,12 @@ void validator::ValidatorImpl::visitLocalVar(ast::LocalVar *var) {
                 validator.getDiags().reportError(diag::TypeInferenceVariableWithNullLiteral, var->tokenRef(ast::PointToInitValueIntroducer));
                 var->resignValidation();
             } else if (!var->getType()) {
-                var->setType(initValTy); // type inference
+                // type inference; the promise of an exclusive value is not inherited by the variables copying it.
+                var->setType(initValTy->isExclusive() ? initValTy->getCanonicalType() : initValTy);
             } else if (var->getType()->isPointerType() && initVal->isNullPointer()) {
                 var->setInitialValue(new ast::NullPointer(var->getType()));
             } else if (initValTy->canAssignTo(var->getType())) {
+                checkStackSlice(initVal, var->getType());
                 var->setInitialValue(new ast::ImplicitCastExpr(initVal, var->getType()));
             } else {
                 validator.getDiags().reportError(diag::NoViableConversion, var->tokenRef(ast::PointToInitValueIntroducer))
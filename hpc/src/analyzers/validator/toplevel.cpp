@@ -32,6 +32,12 @@ void validator::ValidatorImpl::visitNameSpaceDecl(ast::NameSpaceDecl *nameSpace)
 void validator::ValidatorImpl::visitGlobalVar(ast::GlobalVar *var) {
     visitVar(var);
     
+    // any function may access a global, so nothing can be promised about the memory it points to.
+    if (var->getType() && var->getType()->isExclusive()) {
+        validator.getDiags().reportError(diag::ExclusiveGlobalVariable, var->tokenRef(ast::PointToVariableIdentifier)) << var->getName();
+        var->resignValidation();
+    }
+    
     if (ast::Expr *initVal = var->getInitialValue()) {
         if (validate(initVal)) {
             
@@ -40,11 +46,12 @@ void validator::ValidatorImpl::visitGlobalVar(ast::GlobalVar *var) {
                 validator.getDiags().reportError(diag::TypeInferenceVariableWithNullLiteral, var->tokenRef(ast::PointToInitValueIntroducer));
                 var->resignValidation();
             } else if (!var->getType()) {
-                var->setType(initValTy); // type inference
+                // type inference; the promise of an exclusive value is not inherited by the variables copying it.
+                var->setType(initValTy->isExclusive() ? initValTy->getCanonicalType() : initValTy);
             } else if (var->getType()->isPointerType() && initVal->isNullPointer()) {
-                initVal = new ast::NullPointer(var->getType());
+                var->setInitialValue(new ast::NullPointer(var->getType()));
             } else if (initValTy->canAssignTo(var->getType())) {
-                initVal = new ast::ImplicitCastExpr(initVal, var->getType());
+                var->setInitialValue(new ast::ImplicitCastExpr(initVal, var->getType()));
             } else {
                 validator.getDiags().reportError(diag::NoViableConversion, var->tokenRef(ast::PointToInitValueIntroducer))
                     << initValTy->asString() << var->getType()->asString();
@@ -95,8 +102,18 @@ void validator::ValidatorImpl::visitFunctionDecl(ast::FunctionDecl *function) {
     }
     
     if (ast::CompoundStmt *statements = function->getStatementsBlock()) {
+        tailCalls.clear();
+        function->setSlicesStack(false);
         validate(statements);
         
+        // slices are made anywhere in the function, so the tail calls are checked once its whole body is validated.
+        if (function->slicesStack()) {
+            for (ast::ReturnStmt *tailCall : tailCalls) {
+                validator.getDiags().reportError(diag::TailCallSlicesStack, tailCall->tokenRef(ast::PointToStatementQualifier)) << function->getName();
+                function->resignValidation();
+            }
+        }
+        
         if (!statements->returns() && !function->getReturnType()->isVoidType()) {
             validator.getDiags().reportError(diag::ControlReachesEndOfNonVoidFunction, function->tokenRef(ast::PointToEndOfFunction));
             function->resignValidation();
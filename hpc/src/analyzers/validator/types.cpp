@@ -13,9 +13,26 @@
 #include <hpc/ast/types/builtintype.h>
 #include <hpc/ast/types/pointertype.h>
 #include <hpc/ast/types/compoundtype.h>
+#include <hpc/ast/types/vectortype.h>
+#include <hpc/ast/types/arraytype.h>
+#include <hpc/diagnostics/diagnostics.h>
 
 using namespace hpc;
 
+void validator::ValidatorImpl::visitQualifiedType(ast::QualifiedType *type) {
+    
+    if (!validate(type->getEnclosingType())) {
+        type->resignValidation();
+        return;
+    }
+    
+    if (type->isExclusive() && !type->isPointerType() && !type->isSliceType()) {
+        validator.getDiags().reportError(diag::ExclusiveNonPointerType) << type->getEnclosingType()->asString();
+        type->resignValidation();
+    }
+    
+}
+
 void validator::ValidatorImpl::visitPointerType(ast::PointerType *type) {
     
     if (!validate(type->getPointedType())) {
@@ -24,6 +41,55 @@ void validator::ValidatorImpl::visitPointerType(ast::PointerType *type) {
     
 }
 
+void validator::ValidatorImpl::visitVectorType(ast::VectorType *type) {
+    
+    if (!validate(type->getElementType())) {
+        type->resignValidation();
+        return;
+    }
+    
+    ast::Type *elementType = type->getElementType()->getCanonicalType();
+    if (!llvm::isa<ast::BuiltinType>(elementType) || (!elementType->isNumericType() && !elementType->isBooleanType())) {
+        validator.getDiags().reportError(diag::InvalidVectorElementType, nullptr) << type->getElementType()->asString();
+        type->resignValidation();
+    }
+    
+}
+
+void validator::ValidatorImpl::visitArrayType(ast::ArrayType *type) {
+    
+    if (!validate(type->getElementType())) {
+        type->resignValidation();
+        return;
+    }
+    
+    if (type->getElementType()->isVoidType()) {
+        validator.getDiags().reportError(diag::VoidArrayElementType);
+        type->resignValidation();
+        return;
+    }
+    
+    if (type->isStoredByColumns() && !llvm::isa<ast::ClassType>(type->getElementType()->getCanonicalType())) {
+        validator.getDiags().reportError(diag::ColumnsOfNonClassType) << type->getElementType()->asString();
+        type->resignValidation();
+    }
+    
+}
+
+void validator::ValidatorImpl::visitSliceType(ast::SliceType *type) {
+    
+    if (!validate(type->getElementType())) {
+        type->resignValidation();
+        return;
+    }
+    
+    if (type->getElementType()->isVoidType()) {
+        validator.getDiags().reportError(diag::VoidArrayElementType);
+        type->resignValidation();
+    }
+    
+}
+
 void validator::ValidatorImpl::visitClassType(ast::ClassType *type) {
     // TODO
 }
@@ -9,6 +9,7 @@
 
 #include <hpc/analyzers/validator/validator.h>
 #include <hpc/analyzers/validator/resolver.h>
+#include <hpc/ir/builders.h>
 #include <hpc/diagnostics/diagnostics.h>
 #include <hpc/ast/decls/namespace.h>
 
@@ -16,6 +17,21 @@ using namespace hpc;
 
 validator::ValidatorInstance::ValidatorInstance(diag::DiagEngine &diags) : diags(diags) {  }
 
+validator::ValidatorInstance::~ValidatorInstance() {
+    delete layoutBuilder;
+    delete layoutModule;
+}
+
+codegen::ModuleBuilder &validator::ValidatorInstance::getLayoutBuilder() {
+    assert(targetInfo && "No target set.");
+    
+    if (!layoutBuilder) {
+        layoutModule = new modules::ModuleWrapper("layout");
+        layoutBuilder = new codegen::ModuleBuilder(*layoutModule, *targetInfo);
+    }
+    return *layoutBuilder;
+}
+
 bool validator::ValidatorInstance::validate(ast::AbstractSyntaxTree *ast) {
     assert(ast && "No AST has been passed to the validation session.");
 
@@ -73,10 +73,10 @@ ast::TypeAliasDecl *ast::Builder::createTypeAliasDecl(std::string aliasName, Typ
     return newDecl;
 }
 
-ast::ClassDecl *ast::Builder::createClassDecl(std::string className, Symbol *superClass, std::vector<Symbol *> protocols) {
+ast::ClassDecl *ast::Builder::createClassDecl(std::string className, ast::ClassDecl::ClassAttributes attributes, Symbol *superClass, std::vector<Symbol *> protocols) {
     ast::NameSpaceDecl &lib = getInsertNameSpace();
     
-    ast::ClassDecl *newDecl = new ast::ClassDecl(className);
+    ast::ClassDecl *newDecl = new ast::ClassDecl(className, attributes);
     getInsertUnit().addTopLevelDecl(newDecl);
     
     lib.addClass(newDecl);
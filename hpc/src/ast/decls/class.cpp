@@ -18,8 +18,8 @@
 
 using namespace hpc;
 
-ast::ClassDecl::ClassDecl(std::string name, std::string base, std::vector<std::string> protocols)
-: NameSpaceDecl(name), base(base), protocols(protocols), classType(new ast::ClassType(this)) {  }
+ast::ClassDecl::ClassDecl(std::string name, ClassAttributes cattrs, std::string base, std::vector<std::string> protocols)
+: NameSpaceDecl(name), base(base), protocols(protocols), classType(new ast::ClassType(this)), cattrs(cattrs) {  }
 
 ast::FieldDecl *ast::ClassDecl::getFieldDecl(std::string memberid) {
     return fields[memberid];
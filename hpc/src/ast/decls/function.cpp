@@ -52,3 +52,7 @@ bool ast::FunctionDecl::isNostalgic() const {
     return fattrs.nostalgic;
 }
 
+bool ast::FunctionDecl::isRarelyCalled() const {
+    return fattrs.rarely;
+}
+
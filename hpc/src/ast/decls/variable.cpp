@@ -8,5 +8,50 @@
 //
 
 #include <hpc/ast/decls/variable.h>
+#include <hpc/ast/exprs/binary.h>
+#include <hpc/ast/exprs/unary.h>
+#include <hpc/ast/exprs/castings.h>
+#include <hpc/ast/exprs/constant.h>
+#include <hpc/ast/exprs/reference.h>
+#include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/shuffle.h>
 
 using namespace hpc;
+
+/*!
+ \brief Returns whether the value of \c expression is known at compile time, so that it is built as a constant.
+ */
+static bool isConstantInitializer(ast::Expr *expression) {
+    if (llvm::isa<ast::Constant>(expression)) return true;
+
+    if (ast::ImplicitCastExpr *cast = llvm::dyn_cast<ast::ImplicitCastExpr>(expression)) {
+        // a global array cast to a slice is referenced by its address, which is known at link time.
+        ast::VarRef *arrayRef = llvm::dyn_cast<ast::VarRef>(cast->getExpression());
+        if (arrayRef && llvm::isa<ast::GlobalVar>(arrayRef->getVar()) && cast->getDestination()->isSliceType()) return true;
+        
+        return isConstantInitializer(cast->getExpression());
+    }
+    if (ast::EvalExpr *eval = llvm::dyn_cast<ast::EvalExpr>(expression))
+        return isConstantInitializer(eval->getExpression());
+    if (ast::LengthExpr *length = llvm::dyn_cast<ast::LengthExpr>(expression)) {
+        // the length of an array is in its type, so only an entity with side effects is built.
+        ast::Expr *entity = length->getEntity();
+        return entity->evalType()->isArrayType() && (llvm::isa<ast::VarRef>(entity) || isConstantInitializer(entity));
+    }
+    if (ast::ShuffleExpr *shuffle = llvm::dyn_cast<ast::ShuffleExpr>(expression)) {
+        for (ast::Expr *argument : shuffle->getArguments())
+            if (!isConstantInitializer(argument)) return false;
+        return true;
+    }
+    if (ast::BinaryExpr *binary = llvm::dyn_cast<ast::BinaryExpr>(expression))
+        return !llvm::isa<ast::AssignmentExpr>(binary) && isConstantInitializer(binary->getLHS()) && isConstantInitializer(binary->getRHS());
+    if (ast::UnaryExpr *unary = llvm::dyn_cast<ast::UnaryExpr>(expression))
+        return isConstantInitializer(unary->getOperand());
+
+    // the values of other globals are loaded at run-time: a global defined in another source file is only declared in the module being built.
+    return false;
+}
+
+bool ast::GlobalVar::hasConstantInitializer() const {
+    return initval && isConstantInitializer(initval);
+}
@@ -10,6 +10,7 @@
 #include <hpc/ast/exprs/binary.h>
 #include <hpc/ast/exprs/castings.h>
 #include <hpc/ast/types/builtintype.h>
+#include <hpc/ast/types/vectortype.h>
 
 using namespace hpc;
 
@@ -86,6 +87,10 @@ ast::Type *ast::ArithmeticExpr::evalType() {
 }
 
 ast::Type *ast::ComparisonExpr::evalType() {
+    // vectors are compared lane by lane, giving a mask.
+    if (negotiatedType && negotiatedType->isVectorType()) {
+        return VectorType::get(BuiltinType::get(BuiltinType::Boolean), llvm::cast<VectorType>(negotiatedType->getCanonicalType())->getNumLanes());
+    }
     return BuiltinType::get(BuiltinType::Boolean);
 }
 
@@ -9,6 +9,9 @@
 
 #include <hpc/ast/exprs/members.h>
 #include <hpc/ast/types/compoundtype.h>
+#include <hpc/ast/types/vectortype.h>
+#include <hpc/ast/types/arraytype.h>
+#include <hpc/ast/types/builtintype.h>
 #include <hpc/ast/decls/class.h>
 #include <hpc/diagnostics/diagnostics.h>
 
@@ -17,3 +20,37 @@ using namespace hpc;
 ast::Type *ast::FieldRef::evalType() {
     return declaration->getType();
 }
+
+ast::Type *ast::SubscriptExpr::evalType() {
+    ast::Type *entityTy = entity->evalType();
+    if (!entityTy) return nullptr;
+    
+    ast::Type *canonicalType = entityTy->getCanonicalType();
+    
+    if (ast::VectorType *vectorType = llvm::dyn_cast<ast::VectorType>(canonicalType)) return vectorType->getElementType();
+    if (ast::ArrayType *arrayType = llvm::dyn_cast<ast::ArrayType>(canonicalType)) return arrayType->getElementType();
+    if (ast::SliceType *sliceType = llvm::dyn_cast<ast::SliceType>(canonicalType)) return sliceType->getElementType();
+    
+    return nullptr;
+}
+
+bool ast::SubscriptExpr::supportsLeftHandAssignment() const {
+    ast::Type *entityTy = entity->evalType();
+    
+    // a slice refers to elements stored somewhere else.
+    if (entityTy && entityTy->isSliceType()) return true;
+    
+    return entity->supportsLeftHandAssignment();
+}
+
+bool ast::SubscriptExpr::isColumnAccess() const {
+    ast::Type *entityTy = entity->evalType();
+    if (!entityTy) return false;
+    
+    ast::ArrayType *arrayType = llvm::dyn_cast<ast::ArrayType>(entityTy->getCanonicalType());
+    return arrayType && arrayType->isStoredByColumns();
+}
+
+ast::Type *ast::LengthExpr::evalType() {
+    return ast::BuiltinType::get(ast::BuiltinType::SignedLong);
+}
@@ -10,3 +10,24 @@
 #include <hpc/ast/stmt/switchselect.h>
 
 using namespace hpc;
+
+ast::CaseStmt::CaseStmt(const std::vector<Expr *> &values) : values(values) {  }
+
+ast::SwitchStmt::SwitchStmt(Expr *selectionVal, CompoundStmt *block) : selectionVal(selectionVal), block(block) {  }
+
+bool ast::SwitchStmt::returns() const {
+    if (!hasDefault || broken) return false;
+    
+    // every label falls through the statements after the last one, so one of them must return.
+    bool rets = false;
+    for (Stmt *stmt : block->statements()) {
+        if (llvm::isa<CaseStmt>(stmt)) rets = false;
+        else if (stmt->returns()) rets = true;
+    }
+    
+    return rets;
+}
+
+int ast::SwitchStmt::containedReturns() const {
+    return block->containedReturns();
+}
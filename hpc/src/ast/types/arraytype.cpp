@@ -0,0 +1,102 @@
+// => src/ast/types/arraytype.cpp
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#include <hpc/ast/types/arraytype.h>
+
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+
+using namespace hpc;
+
+bool ast::ArrayType::canCastTo(ast::Type *type, bool explicitly) {
+    return canAssignTo(type);
+}
+
+bool ast::ArrayType::canAssignTo(ast::Type *type) {
+    ast::Type *canonicalType = type->getCanonicalType();
+    
+    // an array is seen by a slice through the address of its first element.
+    if (ast::SliceType *sliceType = llvm::dyn_cast<ast::SliceType>(canonicalType)) {
+        return !storedByColumns && ast::Type::areEquivalent(elementType, sliceType->getElementType());
+    }
+    
+    ast::ArrayType *arrayType = llvm::dyn_cast<ast::ArrayType>(canonicalType);
+    return arrayType && arrayType->getLength() == length && arrayType->isStoredByColumns() == storedByColumns &&
+           ast::Type::areEquivalent(elementType, arrayType->getElementType());
+}
+
+std::string ast::ArrayType::str(bool quoted) {
+    std::ostringstream os;
+    
+    if (quoted) os << "'";
+    os << "array of " << length << " " << elementType->str(false);
+    if (storedByColumns) os << " stored by columns";
+    if (quoted) os << "'";
+    
+    return os.str();
+}
+
+ast::ArrayType *ast::ArrayType::get(ast::Type *elementType, uint64_t length, bool storedByColumns) {
+    
+    static std::map<std::tuple<ast::Type *, uint64_t, bool>, ast::ArrayType *> arrayTypes;
+    static std::mutex arrayTypesMutex;
+    std::lock_guard<std::mutex> lock(arrayTypesMutex);
+    
+    if (llvm::isa<QualifiedType>(elementType)) {
+        return new ArrayType(elementType, length, storedByColumns);
+    }
+    
+    ast::ArrayType *&arrayType = arrayTypes[std::make_tuple(elementType, length, storedByColumns)];
+    if (!arrayType) {
+        arrayType = new ArrayType(elementType, length, storedByColumns);
+    }
+    
+    return arrayType;
+}
+
+
+bool ast::SliceType::canCastTo(ast::Type *type, bool explicitly) {
+    return canAssignTo(type);
+}
+
+bool ast::SliceType::canAssignTo(ast::Type *type) {
+    ast::SliceType *sliceType = llvm::dyn_cast<ast::SliceType>(type->getCanonicalType());
+    
+    return sliceType && ast::Type::areEquivalent(elementType, sliceType->getElementType());
+}
+
+std::string ast::SliceType::str(bool quoted) {
+    std::ostringstream os;
+    
+    if (quoted) os << "'";
+    os << "slice of " << elementType->str(false);
+    if (quoted) os << "'";
+    
+    return os.str();
+}
+
+ast::SliceType *ast::SliceType::get(ast::Type *elementType) {
+    
+    static std::map<ast::Type *, ast::SliceType *> sliceTypes;
+    static std::mutex sliceTypesMutex;
+    std::lock_guard<std::mutex> lock(sliceTypesMutex);
+    
+    if (llvm::isa<QualifiedType>(elementType)) {
+        return new SliceType(elementType);
+    }
+    
+    ast::SliceType *&sliceType = sliceTypes[elementType];
+    if (!sliceType) {
+        sliceType = new SliceType(elementType);
+    }
+    
+    return sliceType;
+}
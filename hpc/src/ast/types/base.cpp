@@ -10,6 +10,7 @@
 #include <hpc/ast/types/base.h>
 #include <hpc/ast/types/builtintype.h>
 #include <hpc/ast/types/pointertype.h>
+#include <hpc/ast/types/vectortype.h>
 #include <hpc/ast/decls/class.h>
 #include <hpc/utils/printers.h>
 #include <hpc/analyzers/validator/validator.h>
@@ -38,6 +39,13 @@ ast::Type *ast::Type::getPlaceholderType() {
     return BuiltinType::get(BuiltinType::SignedInteger);
 }
 
+ast::Type *ast::Type::getScalarType() {
+    if (ast::VectorType *vectorType = llvm::dyn_cast<ast::VectorType>(getCanonicalType())) {
+        return vectorType->getElementType()->getCanonicalType();
+    }
+    return this;
+}
+
 std::string ast::Type::asString() {
     std::ostringstream os;
     
@@ -96,7 +104,12 @@ std::string ast::AliasedType::str(bool quoted) {
 }
 
 ast::Type *ast::QualifiedType::getCanonicalType() {
-    return cloneQuals(getEnclosingType()->getCanonicalType());
+    ast::Type *canonicalType = getEnclosingType()->getCanonicalType();
+    
+    // the exclusive qualifier is dropped, so only constant types keep a qualified canonical type.
+    if (!isConstant()) return canonicalType;
+    
+    return cloneQuals(canonicalType);
 }
 
 ast::QualifiedType *ast::QualifiedType::cloneQuals(ast::Type *encType) const {
@@ -112,6 +125,7 @@ std::string ast::QualifiedType::str(bool quoted) {
     
     if (quoted) os << "'";
     if (constQual) os << "constant ";
+    if (exclusiveQual) os << "exclusive ";
     os << getEnclosingType()->str(false);
     if (quoted) os << "'";
     
@@ -8,9 +8,11 @@
 //
 
 #include <hpc/ast/types/builtintype.h>
+#include <hpc/ast/types/vectortype.h>
 #include <hpc/utils/printers.h>
 
 #include <map>
+#include <mutex>
 #include <sstream>
 
 using namespace hpc;
@@ -51,7 +53,10 @@ ast::TypeFormat ast::BuiltinType::getFormat() const {
 
 ast::BuiltinType *ast::BuiltinType::get(TypeID typeID) {
     
+    // types are also created while building modules, which may happen on several threads.
     static std::map<TypeID, BuiltinType *> builtinTypes;
+    static std::mutex builtinTypesMutex;
+    std::lock_guard<std::mutex> lock(builtinTypesMutex);
     
     if (!builtinTypes[typeID]) {
         builtinTypes[typeID] = new BuiltinType(typeID);
@@ -67,6 +72,10 @@ bool ast::BuiltinType::canCastTo(Type *type, bool explicitly) {
     
     if (Type::areEquivalent(this, type)) return true;
     
+    if (ast::VectorType *vectorType = llvm::dyn_cast<ast::VectorType>(type->getCanonicalType())) {
+        return canCastTo(vectorType->getElementType(), explicitly); // the value is splatted to every lane.
+    }
+    
     if (type->isBooleanType()) {
         return isNumericType(); // this is a built-in type, it can't be a pointer.
     }
@@ -95,6 +104,11 @@ bool ast::BuiltinType::canAssignTo(ast::Type *type) {
     if (isVoidType() || type->isVoidType()) return false;
     
     if (Type::areEquivalent(this, type)) return true;
+    
+    if (ast::VectorType *vectorType = llvm::dyn_cast<ast::VectorType>(type->getCanonicalType())) {
+        return canAssignTo(vectorType->getElementType());
+    }
+    
     if (isIntegerType() && type->isIntegerType()) return true;
     if (getFormat() == type->getFormat()) return true;
     
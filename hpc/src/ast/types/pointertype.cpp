@@ -12,6 +12,7 @@
 #include <hpc/utils/printers.h>
 
 #include <map>
+#include <mutex>
 #include <sstream>
 
 using namespace hpc;
@@ -51,6 +52,8 @@ std::string ast::PointerType::str(bool quoted) {
 ast::PointerType *ast::PointerType::get(ast::Type *type) {
     
     static std::map<ast::Type *, ast::PointerType *> pointerTypes;
+    static std::mutex pointerTypesMutex;
+    std::lock_guard<std::mutex> lock(pointerTypesMutex);
     
     if (llvm::isa<QualifiedType>(type)) {
         return new PointerType(type);
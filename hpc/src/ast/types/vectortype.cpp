@@ -0,0 +1,62 @@
+// => src/ast/types/vectortype.cpp
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#include <hpc/ast/types/vectortype.h>
+
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+using namespace hpc;
+
+bool ast::VectorType::canCastTo(ast::Type *type, bool explicitly) {
+    ast::VectorType *vectorType = llvm::dyn_cast<ast::VectorType>(type->getCanonicalType());
+    
+    // lanes are converted one by one, so the number of lanes must match.
+    if (!vectorType || vectorType->getNumLanes() != lanes) return false;
+    
+    return elementType->canCastTo(vectorType->getElementType(), explicitly);
+}
+
+bool ast::VectorType::canAssignTo(ast::Type *type) {
+    ast::VectorType *vectorType = llvm::dyn_cast<ast::VectorType>(type->getCanonicalType());
+    
+    if (!vectorType || vectorType->getNumLanes() != lanes) return false;
+    
+    return elementType->canAssignTo(vectorType->getElementType());
+}
+
+std::string ast::VectorType::str(bool quoted) {
+    std::ostringstream os;
+    
+    if (quoted) os << "'";
+    os << "vector of " << lanes << " " << elementType->str(false);
+    if (quoted) os << "'";
+    
+    return os.str();
+}
+
+ast::VectorType *ast::VectorType::get(ast::Type *elementType, unsigned lanes) {
+    
+    static std::map<std::pair<ast::Type *, unsigned>, ast::VectorType *> vectorTypes;
+    static std::mutex vectorTypesMutex;
+    std::lock_guard<std::mutex> lock(vectorTypesMutex);
+    
+    if (llvm::isa<QualifiedType>(elementType)) {
+        return new VectorType(elementType, lanes);
+    }
+    
+    ast::VectorType *&vectorType = vectorTypes[std::make_pair(elementType, lanes)];
+    if (!vectorType) {
+        vectorType = new VectorType(elementType, lanes);
+    }
+    
+    return vectorType;
+}
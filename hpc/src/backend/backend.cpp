@@ -11,6 +11,7 @@
 #include <hpc/target/target.h>
 #include <hpc/utils/opts.h>
 #include <hpc/linker/input.h>
+#include <hpc/runtime/library.h>
 
 #include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/Triple.h>
@@ -20,6 +21,7 @@
 #include <llvm/CodeGen/LinkAllAsmWriterComponents.h>
 #include <llvm/CodeGen/LinkAllCodegenComponents.h>
 #include <llvm/IR/DataLayout.h>
+#include <llvm/IR/DiagnosticPrinter.h>
 #include <llvm/IR/IRPrintingPasses.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
@@ -61,10 +63,48 @@ static void addAddDiscriminatorsPass(const llvm::PassManagerBuilder &pmb, llvm::
     manager.add(llvm::createAddDiscriminatorsPass());
 }
 
+static void addRuntimeCallsPass(const llvm::PassManagerBuilder &pmb, llvm::legacy::PassManagerBase &manager) {
+    manager.add(runtime::createRuntimeCallsPass());
+}
+
 backend::BackendHelper::BackendHelper(diag::DiagEngine &diags, opts::BackendOptions &backendOptions, target::TargetInfo *targetInfo)
 : diags(diags), backendOptions(backendOptions), targetOptions(targetInfo->getOptions()), targetInfo(targetInfo) {  }
 
 
+void backend::BackendHelper::handleDiagnostic(const llvm::DiagnosticInfo &info, void *context) {
+    BackendHelper *helper = static_cast<BackendHelper *>(context);
+    
+    // the vectorizer reports the loops it was asked to vectorize or interleave and could not,
+    // while the unroller only reports the missed unrolling of the loops with unroll directives.
+    if (info.getKind() == llvm::DK_OptimizationFailure ||
+        (info.getKind() == llvm::DK_OptimizationRemarkMissed && llvm::StringRef(llvm::cast<llvm::OptimizationRemarkMissed>(info).getPassName()) == "loop-unroll")) {
+        const llvm::DiagnosticInfoOptimizationBase &failure = llvm::cast<llvm::DiagnosticInfoOptimizationBase>(info);
+        helper->diags.reportWarning(diag::LoopDirectiveNotHonored) << failure.getFunction().getName().str() << failure.getMsg();
+        return;
+    }
+    
+    // optimization remarks are only printed when requested with the -pass-remarks options.
+    if (const llvm::DiagnosticInfoOptimizationBase *remark = llvm::dyn_cast<llvm::DiagnosticInfoOptimizationBase>(&info)) {
+        if (!remark->isEnabled()) return;
+    }
+    
+    const char *prefix = "error";
+    switch (info.getSeverity()) {
+        case llvm::DS_Error: prefix = "error"; break;
+        case llvm::DS_Warning: prefix = "warning"; break;
+        case llvm::DS_Remark: prefix = "remark"; break;
+        case llvm::DS_Note: prefix = "note"; break;
+    }
+    
+    llvm::DiagnosticPrinterRawOStream printer(llvm::errs());
+    llvm::errs() << prefix << ": ";
+    info.print(printer);
+    llvm::errs() << "\n";
+    
+    // the default handler of LLVM stops the compilation on errors.
+    if (info.getSeverity() == llvm::DS_Error) exit(1);
+}
+
 void backend::BackendHelper::bindTarget(target::TargetInfo *target) {
     targetInfo = target;
     
@@ -73,13 +113,15 @@ void backend::BackendHelper::bindTarget(target::TargetInfo *target) {
 
 void backend::BackendHelper::bindModule(llvm::Module &module) {
     boundmodule = &module;
+    module.getContext().setDiagnosticHandler(handleDiagnostic, this);
     
+    // the target machine is created once, before the validation, and reused for every module.
     bool machineCreated = getTargetInfo().createTargetMachine(backendOptions, diags);
     
-    llvm::TargetMachine *targetMachine = getTargetInfo().getTargetMachine();
+    llvm::TargetMachine *targetMachine = machineCreated ? getTargetInfo().getTargetMachine() : nullptr;
     
     if (machineCreated) {
-        module.setDataLayout(targetMachine->createDataLayout());
+        module.setDataLayout(getTargetInfo().getDataLayout());
     }
     
     
@@ -115,6 +157,9 @@ void backend::BackendHelper::bindModule(llvm::Module &module) {
     
     managerBuilder.addExtension(llvm::PassManagerBuilder::EP_EarlyAsPossible, addAddDiscriminatorsPass);
     
+    // the calls to the runtime are simplified along with instcombine, once inlining and constant propagation made their arguments known.
+    managerBuilder.addExtension(llvm::PassManagerBuilder::EP_Peephole, addRuntimeCallsPass);
+    
 //    if (LangOpts.Sanitize.has(SanitizerKind::LocalBounds)) {
 //        PMBuilder.addExtension(PassManagerBuilder::EP_ScalarOptimizerLate,
 //                               addBoundsCheckingPass);
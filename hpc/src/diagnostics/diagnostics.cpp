@@ -113,6 +113,30 @@ static std::map<diag::DiagID, std::string> diagStrings = {
         "expected member identifier after access operation" },
     { diag::UnexpectedEOF,
         "unexpected end of file" },
+    { diag::ExpectedTokenClass,
+        "expected 'class' after class attributes" },
+    { diag::ExpectedClassAttributeValue,
+        "expected a number of bytes or 'cacheline' after '%0'" },
+    { diag::ExpectedVectorLanes,
+        "expected a number of lanes after 'vector of'" },
+    { diag::ExpectedClosedBracket,
+        "expected ']'" },
+    { diag::ExpectedArrayLength,
+        "expected a number of elements after 'array of'" },
+    { diag::ExpectedStorageOrder,
+        "expected 'by columns' after 'stored'" },
+    { diag::ExpectedColonAfterCase,
+        "expected ':' after case label" },
+    { diag::ExpectedTailCall,
+        "expected 'tail call' after 'as'" },
+    { diag::ExpectedLoopDirective,
+        "expected 'vectorize', 'interleave', 'unroll' or 'independent' loop directive" },
+    { diag::ExpectedDirectiveCount,
+        "expected a positive number after '%0 by'" },
+    { diag::InvalidVectorizeWidth,
+        "vectorization width %0 is not a power of two" },
+    { diag::ExpectedIterationAfterLoop,
+        "expected 'while', 'until', 'do' or 'for' after loop directives" },
     
     { diag::IncompatibleTypesInBinary,
         "invalid operands to binary expression (%0 and %1)" },
@@ -170,6 +194,67 @@ static std::map<diag::DiagID, std::string> diagStrings = {
         "'continue' statement not in a loop statement" },
     { diag::TypeCannotBeSignedOrUnsigned,
         "%0 cannot be signed or unsigned" },
+    { diag::ClassAttributeNotPowerOfTwo,
+        "'%0' value %1 of class '%2' is not a power of two" },
+    { diag::ClassAlignmentTooLarge,
+        "requested alignment %0 of class '%1' is greater than the maximum alignment %2" },
+    { diag::InvalidVectorElementType,
+        "invalid element type %0 for a vector; lanes must be booleans, integers or floating point numbers" },
+    { diag::SubscriptOfInvalidType,
+        "subscripted value of type %0 is not a vector, an array or a slice" },
+    { diag::IndexNotInteger,
+        "index of type %0 is not an integer" },
+    { diag::LaneIndexOutOfRange,
+        "lane index %0 is out of range for a vector of %1 lanes" },
+    { diag::ShuffleOperandNotVector,
+        "shuffled value of type %0 is not a vector" },
+    { diag::ShuffleIndexNotConstant,
+        "shuffle lane indices must be integer literals" },
+    { diag::ShuffledVectorsMismatch,
+        "shuffled vectors have different types (%0 and %1)" },
+    { diag::ArrayIndexOutOfBounds,
+        "index %0 is out of the bounds of an array of %1 elements" },
+    { diag::LengthOfInvalidType,
+        "cannot get the length of a value of type %0, which is not an array or a slice" },
+    { diag::VoidArrayElementType,
+        "elements of arrays and slices cannot be void" },
+    { diag::ColumnsOfNonClassType,
+        "only arrays of classes can be stored by columns, not arrays of %0" },
+    { diag::ExclusiveNonPointerType,
+        "only pointers and slices can be exclusive, not %0" },
+    { diag::ExclusiveGlobalVariable,
+        "'%0' cannot be exclusive, since only parameters and local variables can be" },
+    { diag::SwitchValueNotInteger,
+        "switch value of type '%0' is not an integer" },
+    { diag::CaseNotInSwitch,
+        "case label not directly within a switch statement" },
+    { diag::CaseValueNotConstant,
+        "case value is not an integer constant" },
+    { diag::DuplicateCaseValue,
+        "duplicate case value '%0'" },
+    { diag::MultipleDefaultCases,
+        "multiple default labels in one switch statement" },
+    { diag::TailCallNotACall,
+        "only a function call can be returned as a tail call" },
+    { diag::TailCallSignatureMismatch,
+        "'%0' cannot be a tail call of '%1', since their return and parameter types differ" },
+    { diag::TailCallSlicesStack,
+        "'%0' cannot make tail calls, since it makes slices of its local arrays" },
+    { diag::CaseValueOutOfRange,
+        "case value '%0' is out of range for switch value of type '%1'" },
+    
+    { diag::ClassParameterPassedByValue,
+        "parameter '%0' of type %1 is copied on every call; consider passing only the fields the function uses" },
+    { diag::LoopInvariantCallInCondition,
+        "call to '%0' in loop condition has loop-invariant arguments and is evaluated on every iteration; consider hoisting it out of the loop" },
+    { diag::ImplicitWideningCastInLoop,
+        "implicit conversion from %0 to %1 is performed on every iteration of the loop" },
+    { diag::GlobalInitializerNotConstant,
+        "initial value of global variable '%0' is not a constant and is computed at program startup" },
+    { diag::ClassAlignmentBelowNatural,
+        "requested alignment %0 of class '%1' is lower than its natural alignment %2 and has no effect" },
+    { diag::LoopDirectiveNotHonored,
+        "loop directives in function '%0' were not honored: %1" },
 
     { diag::CandidateFunction,
         "candidate function" },
@@ -113,6 +113,36 @@ void extras::NewASTPrinter::visitFieldRef(ast::FieldRef *fieldRef) {
     closeLastChildBranch();
 }
 
+void extras::NewASTPrinter::visitSubscriptExpr(ast::SubscriptExpr *subscript) {
+    printObject("SubscriptExpr", subscript);
+    os << "\n";
+    
+    openChildBranch(2);
+    takeStmt(subscript->getEntity());
+    takeStmt(subscript->getIndex());
+    closeLastChildBranch();
+}
+
+void extras::NewASTPrinter::visitLengthExpr(ast::LengthExpr *length) {
+    printObject("LengthExpr", length);
+    os << "\n";
+    
+    openChildBranch(1);
+    takeStmt(length->getEntity());
+    closeLastChildBranch();
+}
+
+void extras::NewASTPrinter::visitShuffleExpr(ast::ShuffleExpr *shuffle) {
+    printObject("ShuffleExpr", shuffle);
+    os << "\n";
+    
+    openChildBranch(shuffle->getArguments().size());
+    for (ast::Expr *argument : shuffle->getArguments()) {
+        takeStmt(argument);
+    }
+    closeLastChildBranch();
+}
+
 
 void extras::NewASTPrinter::visitGlobalVar(ast::GlobalVar *var) {
     printObject("GlobalVar", var);
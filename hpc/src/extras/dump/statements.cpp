@@ -11,6 +11,23 @@
 
 using namespace hpc;
 
+/*!
+ \brief Prints the optimization directives given to a loop, if any.
+ */
+static void printDirectives(llvm::raw_ostream &os, const ast::LoopDirectives &directives) {
+    if (directives.vectorize) {
+        os << " vectorize";
+        if (directives.vectorizeWidth) os << " by " << directives.vectorizeWidth;
+    }
+    if (directives.interleaveCount) os << " interleave by " << directives.interleaveCount;
+    if (directives.unrollFully) os << " unroll fully";
+    else if (directives.unroll) {
+        os << " unroll";
+        if (directives.unrollCount) os << " by " << directives.unrollCount;
+    }
+    if (directives.independent) os << " independent";
+}
+
 void extras::NewASTPrinter::visitCompoundStmt(ast::CompoundStmt *statement) {
     printObject("CompoundStmt", statement);
     os << "\n";
@@ -60,6 +77,8 @@ void extras::NewASTPrinter::visitContinueStmt(ast::ContinueStmt *statement) {
 
 void extras::NewASTPrinter::visitIfStmt(ast::IfStmt *statement) {
     printObject("IfStmt", statement);
+    if (statement->getBranchHint() == ast::IfStmt::Likely) os << " likely";
+    else if (statement->getBranchHint() == ast::IfStmt::Unlikely) os << " unlikely";
     os << "\n";
     
     openChildBranch(3);
@@ -81,7 +100,32 @@ void extras::NewASTPrinter::visitIfStmt(ast::IfStmt *statement) {
     closeLastChildBranch();
 }
 
+void extras::NewASTPrinter::visitSwitchStmt(ast::SwitchStmt *statement) {
+    printObject("SwitchStmt", statement);
+    os << "\n";
+    
+    openChildBranch(2);
+    takeStmt(statement->getSelectionValue());
+    takeStmt(statement->getBlock());
+    closeLastChildBranch();
+}
+
+void extras::NewASTPrinter::visitCaseStmt(ast::CaseStmt *statement) {
+    printObject("CaseStmt", statement);
+    if (statement->isDefault()) os << " default";
+    os << "\n";
+    
+    if (!statement->isDefault()) {
+        openChildBranch(statement->getValues().size());
+        for (ast::Expr *value : statement->getValues()) {
+            takeStmt(value);
+        }
+        closeLastChildBranch();
+    }
+}
+
 void extras::NewASTPrinter::visitSimpleIterStmt(ast::SimpleIterStmt *statement) {
+    printDirectives(os, statement->getDirectives());
     os << "\n";
     
     openChildBranch(2);
@@ -118,6 +162,7 @@ void extras::NewASTPrinter::visitPostUntilStmt(ast::PostUntilStmt *statement) {
 
 void extras::NewASTPrinter::visitForStmt(ast::ForStmt *statement) {
     printObject("ForStmt", statement);
+    printDirectives(os, statement->getDirectives());
     os << "\n";
     
     openChildBranch(statement->getInitStatements().size() + statement->getEndStatements().size() + 2);
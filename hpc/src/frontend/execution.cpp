@@ -22,13 +22,21 @@
 #include <hpc/analyzers/lexer/lexer.h>
 #include <hpc/analyzers/parser/parser.h>
 #include <hpc/analyzers/validator/validator.h>
+#include <hpc/analyzers/validator/performance.h>
+#include <hpc/analyzers/simplifier/simplifier.h>
+#include <hpc/analyzers/reachability/reachability.h>
+#include <hpc/analyzers/purity/purity.h>
+#include <hpc/analyzers/bounds/bounds.h>
 #include <hpc/ir/modules.h>
 #include <hpc/ir/builders.h>
 #include <hpc/target/target.h>
 #include <hpc/backend/backend.h>
 #include <hpc/linker/linker.h>
 
+#include <algorithm>
+#include <atomic>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace hpc;
@@ -81,7 +89,11 @@ bool hpc::CompilerInstance::executeInvocation() {
     
     if (getDiagnostics().getErrorCount()) return false;
     
+    // class attributes are checked, and class layouts built, against the target data layout.
+    if (!targetInfo->createTargetMachine(getBackendOptions(), getDiagnostics())) return false;
+    
     validator::ValidatorInstance validator(getDiagnostics());
+    validator.setTargetInfo(targetInfo);
     
     validator.validate(AST);
     
@@ -91,14 +103,62 @@ bool hpc::CompilerInstance::executeInvocation() {
     
     if (getDiagnostics().getErrorCount()) return false;
     
+    simplifier::ASTSimplifier simplifier;
+    simplifier.simplifyAST(AST);
+    
+    purity::PurityAnalysis purity;
+    purity.analyze(AST);
+    
+    // -Wperformance
+    if (getDiagOptions().performanceWarnings) {
+        validator::PerformanceLint lint(getDiagnostics(), purity);
+        lint.lintAST(AST);
+    }
+    
+    reachability::ReachabilityAnalysis reachableDecls;
+    if (frontendOpts.wholeProgram) reachableDecls.analyze(AST);
+    
+    bounds::BoundsCheckAnalysis boundsChecks;
+    if (frontendOpts.boundsChecks) boundsChecks.analyze(AST);
+    
+    // each source file has its own module and LLVM context, so the modules are built in parallel.
+    // The AST and the analyses are only read from now on.
+    std::vector<std::pair<source::SourceFile *, ast::CompilationUnit *>> units;
     for (source::SourceFile *src : sourcefiles)
-        if (ast::CompilationUnit *theUnit = AST->getUnitForFile(src)) {
+        if (ast::CompilationUnit *theUnit = AST->getUnitForFile(src)) units.push_back({ src, theUnit });
+    
+    // the data layout of the target is created on first use, so it is created before the threads copy it into their builders.
+    targetInfo->getDataLayout();
+    
+    std::atomic<unsigned> nextUnit(0);
+    auto buildModules = [&]() {
+        for (unsigned i = nextUnit++; i < units.size(); i = nextUnit++) {
+            source::SourceFile *src = units[i].first;
+            ast::CompilationUnit *theUnit = units[i].second;
+            
             codegen::ModuleBuilder builder(*src->getModuleWrapper(), *targetInfo);
+            if (frontendOpts.wholeProgram) builder.setReachableDecls(&reachableDecls);
+            builder.setPurityAnalysis(&purity);
+            builder.setBoundsChecks(frontendOpts.boundsChecks, &boundsChecks);
+            builder.setStrictAliasing(frontendOpts.strictAliasing);
+            builder.setClassLayoutOptions(frontendOpts.reorderClassFields, frontendOpts.dumpClassLayouts);
+            builder.setDirectSSA(frontendOpts.directSSA);
+            
             builder.buildUnit(theUnit);
             
             src->getModuleWrapper()->finalize();
             src->getModuleWrapper()->getModule().setTargetTriple(targetInfo->getTriple());
         }
+    };
+    
+    unsigned threads = frontendOpts.codegenThreads ? frontendOpts.codegenThreads : std::max(std::thread::hardware_concurrency(), 1u);
+    if (frontendOpts.dumpClassLayouts) threads = 1; // the layouts are printed in the order of the source files.
+    threads = std::min<unsigned>(threads, units.size());
+    
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < threads; i++) workers.emplace_back(buildModules);
+    buildModules();
+    for (std::thread &worker : workers) worker.join();
     
     fsys::FileType backendoutput = frontendOpts.outputType;
     
@@ -27,6 +27,20 @@ static bool parseFrontendArgs(CompilerInvocation &invoke, diag::DiagEngine &diag
     
     frontendOpts.outputFile = args.getLastArgValue(opts::o);
     
+    frontendOpts.wholeProgram = args.hasArg(opts::fwhole_program);
+    frontendOpts.reorderClassFields = args.hasArg(opts::freorder_class_fields);
+    frontendOpts.dumpClassLayouts = args.hasArg(opts::fdump_class_layouts);
+    frontendOpts.boundsChecks = !args.hasArg(opts::fno_bounds_checks);
+    frontendOpts.strictAliasing = !args.hasArg(opts::fno_strict_aliasing);
+    frontendOpts.directSSA = args.hasArg(opts::fdirect_ssa);
+    
+    if (llvm::opt::Arg *threadsArg = args.getLastArg(opts::fcodegen_threads)) {
+        llvm::StringRef value = threadsArg->getValue();
+        if (value.getAsInteger(10, frontendOpts.codegenThreads)) {
+            diags.reportDiag(diag::Error, diag::InvalidOptionValueInFlag) << value.str() << threadsArg->getAsString(args);
+        }
+    }
+    
     for (std::string input : args.getAllArgValues(opts::InputFiles)) {
         fsys::InputFile *ifile = fsys::InputFile::fromFile(input);
         
@@ -41,6 +55,15 @@ static bool parseFrontendArgs(CompilerInvocation &invoke, diag::DiagEngine &diag
     return true;
 }
 
+static bool parseDiagnosticsArgs(CompilerInvocation &invoke, diag::DiagEngine &diags, llvm::opt::InputArgList &args) {
+    
+    opts::DiagnosticsOptions &diagOpts = invoke.getDiagOptions();
+    
+    diagOpts.performanceWarnings = args.hasFlag(opts::Wperformance, opts::Wno_performance, false);
+    
+    return true;
+}
+
 static bool parseTargetArgs(CompilerInvocation &invoke, diag::DiagEngine &diags, llvm::opt::InputArgList &args) {
     
     opts::TargetOptions &targetOpts = invoke.getTargetOptions();
@@ -90,6 +113,7 @@ bool CompilerInvocation::create(CompilerInstance &hpc, const char **argBegin, co
     CompilerInvocation *invoke = new CompilerInvocation(hpc);
 
     parseFrontendArgs(*invoke, diags, args);
+    parseDiagnosticsArgs(*invoke, diags, args);
     parseTargetArgs(*invoke, diags, args);
     
     
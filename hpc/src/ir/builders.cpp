@@ -14,6 +14,7 @@
 #include <hpc/ast/types/pointertype.h>
 #include <hpc/ast/types/compoundtype.h>
 #include <hpc/ast/decls/class.h>
+#include <hpc/ast/decls/function.h>
 #include <hpc/ast/exprs/reference.h>
 #include <hpc/ast/exprs/members.h>
 #include <hpc/target/target.h>
@@ -25,20 +26,36 @@ using namespace hpc;
 
 codegen::SymbolTable::SymbolTable(ModuleBuilder &moduleBuilder) : moduleBuilder(moduleBuilder) {  }
 
+void codegen::SymbolTable::pushFunction() {
+    functionTables.emplace_back();
+}
+
+void codegen::SymbolTable::popFunction() {
+    assert(!functionTables.empty() && "No function is being built.");
+    functionTables.pop_back();
+}
+
+llvm::DenseMap<ast::Component *, llvm::Value *> &codegen::SymbolTable::getComponentTable(ast::Component *component) {
+    if (llvm::isa<ast::FunctionDecl>(component) || llvm::isa<ast::GlobalVar>(component)) return globalTable;
+    
+    assert(!functionTables.empty() && "Local component built outside a function.");
+    return functionTables.back().componentTable;
+}
+
 void codegen::SymbolTable::setValForComponent(ast::Component *component, llvm::Value *value) {
-    componentTable[component] = value;
+    getComponentTable(component)[component] = value;
 }
 
 void codegen::SymbolTable::setValForComponent(ast::Component &component, llvm::Value *value) {
-    componentTable[&component] = value;
+    setValForComponent(&component, value);
 }
 
 llvm::Value *codegen::SymbolTable::getValForComponent(ast::Component *component) {
-    return componentTable[component];
+    return getComponentTable(component).lookup(component);
 }
 
 llvm::Value *codegen::SymbolTable::getValForComponent(ast::Component &component) {
-    return componentTable[&component];
+    return getValForComponent(&component);
 }
 
 void codegen::SymbolTable::setIRType(ast::Type *type, llvm::Type *irtype) {
@@ -50,16 +67,27 @@ void codegen::SymbolTable::setIRType(ast::Type &type, llvm::Type *irtype) {
 }
 
 llvm::Type *codegen::SymbolTable::getIRType(ast::Type *type) {
-    if (!typeTable[type]) {
+    if (!typeTable.lookup(type)) {
         moduleBuilder.takeType(type);
     }
-    return typeTable[type];
+    return typeTable.lookup(type);
 }
 
 llvm::Type *codegen::SymbolTable::getIRType(ast::Type &type) {
     return getIRType(&type);
 }
 
+void codegen::SymbolTable::setFieldSlot(ast::FieldDecl *field, unsigned slot) {
+    fieldTable[field] = slot;
+}
+
+unsigned codegen::SymbolTable::getFieldSlot(ast::FieldDecl *field) {
+    if (!fieldTable.count(field)) {
+        getIRType(field->getEnclosingType()); // slots are assigned when the class structure is built.
+    }
+    return fieldTable.lookup(field);
+}
+
 llvm::Value *codegen::SymbolTable::getOrCreateReference(ast::Component *component) {
     if (ast::Var *var = llvm::dyn_cast<ast::Var>(component)) {
         return getValForComponent(var);
@@ -70,12 +98,20 @@ llvm::Value *codegen::SymbolTable::getOrCreateReference(ast::Component *componen
     }
     
     if (ast::FieldRef *fieldRef = llvm::dyn_cast<ast::FieldRef>(component)) {
+        // each field of an array stored by columns has its own array.
+        ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(fieldRef->getEntity());
+        if (subscript && subscript->isColumnAccess()) return moduleBuilder.getElementReference(subscript, fieldRef->getDeclaration());
+        
         return moduleBuilder.getInstBuilder().CreateStructGEP(getIRType(fieldRef->getDeclaration()->getEnclosingType()),
                                                               getOrCreateReference(fieldRef->getEntity()),
-                                                              fieldRef->getDeclaration()->getFieldIndex()
+                                                              getFieldSlot(fieldRef->getDeclaration())
                                                               );
     }
     
+    if (ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(component)) {
+        if (!subscript->getEntity()->evalType()->isVectorType() && !subscript->isColumnAccess()) return moduleBuilder.getElementReference(subscript);
+    }
+    
     return nullptr;
 }
 
@@ -84,15 +120,15 @@ llvm::Value *codegen::SymbolTable::getOrCreateReference(ast::Component &componen
 }
 
 void codegen::SymbolTable::setBreakBlock(ast::Stmt &stmt, llvm::BasicBlock *block) {
-    breakTable[&stmt] = block;
+    functionTables.back().breakTable[&stmt] = block;
 }
 
 void codegen::SymbolTable::setContinueBlock(ast::Stmt &stmt, llvm::BasicBlock *block) {
-    continueTable[&stmt] = block;
+    functionTables.back().continueTable[&stmt] = block;
 }
 
-llvm::GlobalVariable *codegen::SymbolTable::getOrCreateStringConstant(runtime::string_ty str) {
-    if (!stringTable[str]) {
+llvm::Constant *codegen::SymbolTable::getOrCreateStringConstant(runtime::string_ty str) {
+    if (!stringTable.lookup(str)) {
         
         llvm::Module &module = moduleBuilder.getModule();
         
@@ -106,27 +142,70 @@ llvm::GlobalVariable *codegen::SymbolTable::getOrCreateStringConstant(runtime::s
                                                                         arrayType,
                                                                         /*isConstant=*/true,
                                                                         llvm::GlobalValue::PrivateLinkage,
-                                                                        llvm::ConstantDataArray::getString(module.getContext(), str.c_str()),
+                                                                        llvm::ConstantDataArray::getString(module.getContext(), str),
                                                                         ".str"
                                                                         );
         
-        stringConstant->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Local); // FIXME alignment
-        //strcst->setAlignment(chrtype->getAlignment());
-
-        stringTable[str] = stringConstant;
+        // the address of a literal is never compared, so the constant goes to a mergeable string section:
+        // the linker keeps a single copy of the identical strings of all the object files, and shares the strings ending other ones.
+        stringConstant->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+        stringConstant->setAlignment(moduleBuilder.getDataLayout().getABITypeAlignment(getIRType(charType)));
+
+        // the pointer is folded once, instead of for every literal.
+        llvm::Constant *zero = llvm::ConstantInt::get(llvm::Type::getInt32Ty(module.getContext()), 0);
+        llvm::Constant *indices[] = { zero, zero };
+        stringTable[str] = llvm::ConstantExpr::getInBoundsGetElementPtr(arrayType, stringConstant, indices);
         
     }
-    return stringTable[str];
+    return stringTable.lookup(str);
 }
 
 llvm::BranchInst *codegen::SymbolTable::makeBreak(ast::Stmt *stmt) {
-    return moduleBuilder.getInstBuilder().CreateBr(breakTable[stmt]);
+    return moduleBuilder.getInstBuilder().CreateBr(functionTables.back().breakTable.lookup(stmt));
 }
 
 llvm::BranchInst *codegen::SymbolTable::makeContinue(ast::Stmt *stmt) {
-    return moduleBuilder.getInstBuilder().CreateBr(continueTable[stmt]);
+    return moduleBuilder.getInstBuilder().CreateBr(functionTables.back().continueTable.lookup(stmt));
 }
 
 
 codegen::ModuleBuilder::ModuleBuilder(modules::ModuleWrapper &moduleWrapper, target::TargetInfo &targetInfo)
-    : moduleWrapper(moduleWrapper), targetInfo(targetInfo), table(*this) {  }
+    : moduleWrapper(moduleWrapper), targetInfo(targetInfo), dataLayout(targetInfo.getDataLayout()), table(*this) {  }
+
+codegen::ModuleBuilder::FunctionState codegen::ModuleBuilder::suspendFunction() {
+    FunctionState state = { builder, returnBlock, returnRegister, trapBlock, std::move(scopes), std::move(aliasScopes),
+                             std::move(ssaDefinitions), std::move(sealedBlocks), std::move(incompletePhis) };
+    
+    builder = nullptr;
+    returnBlock = nullptr;
+    returnRegister = nullptr;
+    trapBlock = nullptr;
+    scopes.clear();
+    aliasScopes.clear();
+    ssaDefinitions.clear();
+    sealedBlocks.clear();
+    incompletePhis.clear();
+    
+    return state;
+}
+
+void codegen::ModuleBuilder::resumeFunction(FunctionState &state) {
+    builder = state.builder;
+    returnBlock = state.returnBlock;
+    returnRegister = state.returnRegister;
+    trapBlock = state.trapBlock;
+    scopes = std::move(state.scopes);
+    aliasScopes = std::move(state.aliasScopes);
+    ssaDefinitions = std::move(state.ssaDefinitions);
+    sealedBlocks = std::move(state.sealedBlocks);
+    incompletePhis = std::move(state.incompletePhis);
+}
+
+bool codegen::ModuleBuilder::shouldBuild(ast::Decl *decl) const {
+    if (!reachableDecls) return true;
+    
+    if (llvm::isa<ast::FunctionDecl>(decl) || llvm::isa<ast::GlobalVar>(decl) || llvm::isa<ast::ClassDecl>(decl)) {
+        return reachableDecls->isReachable(decl);
+    }
+    return true;
+}
@@ -9,11 +9,152 @@
 
 #include <hpc/ir/builders.h>
 #include <hpc/ast/decls/class.h>
+#include <hpc/ast/types/compoundtype.h>
+#include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/reference.h>
 
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/Value.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
 
 using namespace hpc;
 
-void codegen::ModuleBuilder::visitClassDecl(ast::ClassDecl *classDecl) {
+static void printLayout(llvm::raw_ostream &os, const char *title, llvm::DataLayout &dataLayout, llvm::StructType *structType,
+                        const std::vector<ast::FieldDecl *> &fields, const std::vector<unsigned> &slots) {
+    const llvm::StructLayout *structLayout = dataLayout.getStructLayout(structType);
+    
+    uint64_t fieldsSize = 0;
+    for (unsigned slot : slots) fieldsSize += dataLayout.getTypeAllocSize(structType->getElementType(slot));
+    
+    os << "  " << title << ": size " << structLayout->getSizeInBytes()
+       << ", alignment " << structLayout->getAlignment()
+       << ", padding " << structLayout->getSizeInBytes() - fieldsSize << "\n";
+    
+    for (unsigned i = 0; i < fields.size(); i++) {
+        os << "    offset " << structLayout->getElementOffset(slots[i]) << ": " << fields[i]->getName()
+           << " (" << fields[i]->getType()->str(false) << ", size " << dataLayout.getTypeAllocSize(structType->getElementType(slots[i])) << ")\n";
+    }
+}
+
+std::vector<ast::FieldDecl *> codegen::ModuleBuilder::getFieldsLayout(ast::ClassDecl *classDecl) {
+    std::vector<ast::FieldDecl *> layout = classDecl->getFields();
+
+    if (!reorderClassFields || classDecl->isPinned()) return layout;
+
+    // Sorting by decreasing alignment leaves no padding between fields, since the size of a type is a multiple of its alignment.
+    // The alignment requested for the classes of the fields counts, as they are padded to it.
+    // The sort is stable, so fields with the same alignment keep their declaration order.
+    std::stable_sort(layout.begin(), layout.end(), [&](ast::FieldDecl *field1, ast::FieldDecl *field2) {
+        return getAlignment(field1->getType()) > getAlignment(field2->getType());
+    });
+
+    return layout;
+}
+
+void codegen::ModuleBuilder::dumpClassLayout(ast::ClassDecl *classDecl) {
+    llvm::DataLayout &dataLayout = getDataLayout();
+    llvm::raw_ostream &os = llvm::outs();
+    
+    const std::vector<ast::FieldDecl *> &declared = classDecl->getFields();
+    std::vector<ast::FieldDecl *> built = getFieldsLayout(classDecl);
+    
+    // the declared layout is padded like the built one, so that only the order of the fields differs.
+    std::vector<unsigned> declaredSlots, builtSlots;
+    std::vector<llvm::Type *> declaredTypes = getClassElementTypes(classDecl, declared, declaredSlots);
+    
+    llvm::StructType *declaredType = llvm::StructType::get(getModule().getContext(), declaredTypes, classDecl->isPacked());
+    llvm::StructType *builtType = llvm::cast<llvm::StructType>(getIRType(classDecl->getType()));
+    
+    for (ast::FieldDecl *field : built) builtSlots.push_back(table.getFieldSlot(field));
+    
+    os << "class '" << classDecl->getStringPath() << "'";
+    if (classDecl->isPinned()) os << " (pinned)";
+    if (classDecl->isPacked()) os << " (packed)";
+    if (unsigned alignment = getTargetInfo().getClassAlignment(classDecl)) os << " (aligned to " << alignment << ")";
+    if (unsigned padding = getClassPadding(classDecl)) os << " (padded to " << padding << ")";
+    os << "\n";
+    
+    printLayout(os, "declared", dataLayout, declaredType, declared, declaredSlots);
+    printLayout(os, "built", dataLayout, builtType, built, builtSlots);
+}
+
+unsigned codegen::ModuleBuilder::getClassPadding(ast::ClassDecl *classDecl) {
+    unsigned padding = classDecl->getRequestedPadding();
+    if (classDecl->isCacheLinePadded()) padding = std::max(padding, getTargetInfo().getCacheLineSize());
     
+    return padding;
+}
+
+unsigned codegen::ModuleBuilder::getRequestedAlignment(ast::Type *type) {
+    unsigned alignment = getTargetInfo().getRequestedAlignment(type);
+    if (!alignment) return 0;
+    
+    // an alignment lower than the one of the structure would make the accesses to its fields misaligned.
+    return std::max<unsigned>(alignment, getDataLayout().getABITypeAlignment(getIRType(type)));
+}
+
+unsigned codegen::ModuleBuilder::getAlignment(ast::Type *type) {
+    if (unsigned alignment = getRequestedAlignment(type)) return alignment;
+    
+    return getDataLayout().getABITypeAlignment(getIRType(type));
+}
+
+unsigned codegen::ModuleBuilder::getAccessAlignment(ast::Expr *reference) {
+    ast::Expr *entity = reference;
+    while (true) {
+        if (ast::FieldRef *fieldRef = llvm::dyn_cast<ast::FieldRef>(entity)) {
+            // columns are not packed, even when their class is.
+            ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(fieldRef->getEntity());
+            if (subscript && subscript->isColumnAccess()) break;
+            
+            if (fieldRef->getDeclaration()->getContainerClass()->isPacked()) return 1;
+            entity = fieldRef->getEntity();
+        } else if (ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(entity)) {
+            // elements of an array are stored in the array.
+            if (!subscript->getEntity()->evalType()->isArrayType()) break;
+            entity = subscript->getEntity();
+        } else break;
+    }
+    
+    return getAlignment(reference->evalType());
+}
+
+bool codegen::ModuleBuilder::isObjectType(ast::Type *type) {
+    type = type->getCanonicalType();
+    if (ast::QualifiedType *qualType = llvm::dyn_cast<ast::QualifiedType>(type)) type = qualType->getEnclosingType()->getCanonicalType();
+    
+    return llvm::isa<ast::ClassType>(type);
+}
+
+llvm::Value *codegen::ModuleBuilder::createObjectCopy(ast::Expr *source, llvm::Value *destination, unsigned alignment, bool isFresh) {
+    ast::Type *type = source->evalType();
+    uint64_t size = getDataLayout().getTypeAllocSize(getIRType(type));
+    
+    ast::FunctionCall *functionCall = llvm::dyn_cast<ast::FunctionCall>(source);
+    if (functionCall && getFunctionABI(functionCall->getFunctionDecl()).returnInfo.kind == target::ABIArgInfo::Indirect) {
+        if (isFresh) return createCall(functionCall, destination);
+        
+        // the object is moved out of a temporary which is dead after the copy.
+        llvm::AllocaInst *temporary = createTemporary(getIRType(type), getAlignment(type));
+        llvm::ConstantInt *temporarySize = builder->getInt64(size);
+        
+        builder->CreateLifetimeStart(temporary, temporarySize);
+        createCall(functionCall, temporary);
+        llvm::CallInst *copy = builder->CreateMemCpy(destination, temporary, size, std::min(alignment, getAlignment(type)));
+        builder->CreateLifetimeEnd(temporary, temporarySize);
+        return copy;
+    }
+    
+    if (llvm::Value *reference = table.getOrCreateReference(source)) {
+        return builder->CreateMemCpy(destination, reference, size, std::min(alignment, getAccessAlignment(source)));
+    }
+    
+    return builder->CreateAlignedStore(build(source), destination, alignment);
+}
+
+void codegen::ModuleBuilder::visitClassDecl(ast::ClassDecl *classDecl) {
+    if (dumpClassLayouts) dumpClassLayout(classDecl);
 }
@@ -0,0 +1,176 @@
+// => src/ir/exprs/arrays.cpp
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#include <hpc/ir/builders.h>
+#include <hpc/ast/types/arraytype.h>
+#include <hpc/ast/types/compoundtype.h>
+#include <hpc/ast/decls/class.h>
+#include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/reference.h>
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Intrinsics.h>
+#include <llvm/IR/Value.h>
+
+#include <algorithm>
+
+using namespace hpc;
+
+/*!
+ \brief Returns the class of the elements of the given array stored by columns.
+ */
+static ast::ClassDecl *getColumnsClass(ast::ArrayType *arrayType) {
+    return llvm::cast<ast::ClassType>(arrayType->getElementType()->getCanonicalType())->getDeclarator();
+}
+
+llvm::Value *codegen::ModuleBuilder::getOrSpillReference(ast::Expr *expression) {
+    if (llvm::Value *reference = table.getOrCreateReference(expression)) return reference;
+    
+    llvm::Value *value = build(expression);
+    
+    llvm::AllocaInst *temporary = createTemporary(value->getType(), getAlignment(expression->evalType()));
+    builder->CreateAlignedStore(value, temporary, getAlignment(expression->evalType()));
+    
+    return temporary;
+}
+
+llvm::AllocaInst *codegen::ModuleBuilder::createTemporary(llvm::Type *type, unsigned alignment) {
+    llvm::Function *irfunc = builder->GetInsertBlock()->getParent();
+    llvm::IRBuilder<> entryBuilder(&irfunc->getEntryBlock(), irfunc->getEntryBlock().begin());
+    
+    llvm::AllocaInst *temporary = entryBuilder.CreateAlloca(type);
+    temporary->setAlignment(alignment);
+    return temporary;
+}
+
+llvm::Value *codegen::ModuleBuilder::createIndex(llvm::Value *value, ast::Type *type) {
+    if (type->getCanonicalType()->isSignedIntegerType()) {
+        return builder->CreateSExtOrTrunc(value, builder->getInt64Ty());
+    }
+    return builder->CreateZExtOrTrunc(value, builder->getInt64Ty());
+}
+
+void codegen::ModuleBuilder::createBoundsCheck(llvm::Value *inBounds) {
+    llvm::Function *irfunc = builder->GetInsertBlock()->getParent();
+    
+    if (!trapBlock) {
+        trapBlock = llvm::BasicBlock::Create(builder->getContext(), "", irfunc);
+        
+        llvm::IRBuilder<> trapBuilder(trapBlock);
+        trapBuilder.CreateCall(llvm::Intrinsic::getDeclaration(&getModule(), llvm::Intrinsic::trap));
+        trapBuilder.CreateUnreachable();
+    }
+    
+    llvm::BasicBlock *continueBlock = llvm::BasicBlock::Create(builder->getContext());
+    
+    builder->CreateCondBr(inBounds, continueBlock, trapBlock);
+    irfunc->getBasicBlockList().push_back(continueBlock);
+    sealBlock(continueBlock);
+    builder->SetInsertPoint(continueBlock);
+}
+
+llvm::Value *codegen::ModuleBuilder::createCheckedIndex(ast::SubscriptExpr *subscript, llvm::Value *length) {
+    llvm::Value *index = createIndex(build(subscript->getIndex()), subscript->getIndex()->evalType());
+    
+    // the validator only checks the integer literals, so the indexes folded to constants are checked here.
+    llvm::ConstantInt *constantIndex = llvm::dyn_cast<llvm::ConstantInt>(index);
+    llvm::ConstantInt *constantLength = llvm::dyn_cast<llvm::ConstantInt>(length);
+    if (constantIndex && constantLength) {
+        if (constantIndex->getValue().ult(constantLength->getValue())) return index;
+        
+        // the access is always out of bounds, so it traps even without run-time checks, costing nothing to correct programs.
+        createBoundsCheck(builder->getFalse());
+        return index;
+    }
+    
+    if (boundsChecks && (!boundsCheckAnalysis || boundsCheckAnalysis->needsCheck(subscript))) {
+        // a negative index becomes larger than any length once compared as unsigned.
+        createBoundsCheck(builder->CreateICmpULT(index, length));
+    }
+    
+    return index;
+}
+
+llvm::Value *codegen::ModuleBuilder::getColumnReference(ast::ArrayType *arrayType, llvm::Value *arrayRef, ast::FieldDecl *field, llvm::Value *index) {
+    const std::vector<ast::FieldDecl *> &fields = getColumnsClass(arrayType)->getFields();
+    unsigned column = std::find(fields.begin(), fields.end(), field) - fields.begin();
+    
+    return builder->CreateInBoundsGEP(getIRType(arrayType), arrayRef, { builder->getInt64(0), builder->getInt32(column), index });
+}
+
+llvm::Value *codegen::ModuleBuilder::getElementReference(ast::SubscriptExpr *subscript, ast::FieldDecl *field) {
+    ast::Expr *entity = subscript->getEntity();
+    ast::Type *entityType = entity->evalType()->getCanonicalType();
+    
+    if (ast::ArrayType *arrayType = llvm::dyn_cast<ast::ArrayType>(entityType)) {
+        llvm::Value *arrayRef = getOrSpillReference(entity);
+        llvm::Value *index = createCheckedIndex(subscript, builder->getInt64(arrayType->getLength()));
+        
+        if (arrayType->isStoredByColumns()) {
+            assert(field && "Elements of arrays stored by columns have no address.");
+            return getColumnReference(arrayType, arrayRef, field, index);
+        }
+        
+        return builder->CreateInBoundsGEP(getIRType(arrayType), arrayRef, { builder->getInt64(0), index });
+    }
+    
+    ast::SliceType *sliceType = llvm::cast<ast::SliceType>(entityType);
+    
+    llvm::Value *slice = build(entity);
+    llvm::Value *index = createCheckedIndex(subscript, builder->CreateExtractValue(slice, 1));
+    
+    return builder->CreateInBoundsGEP(getIRType(sliceType->getElementType()), builder->CreateExtractValue(slice, 0), index);
+}
+
+llvm::Value *codegen::ModuleBuilder::loadColumns(ast::SubscriptExpr *subscript) {
+    ast::ArrayType *arrayType = llvm::cast<ast::ArrayType>(subscript->getEntity()->evalType()->getCanonicalType());
+    
+    llvm::Value *arrayRef = getOrSpillReference(subscript->getEntity());
+    llvm::Value *index = createCheckedIndex(subscript, builder->getInt64(arrayType->getLength()));
+    
+    // the element is gathered from every column.
+    llvm::Value *element = llvm::UndefValue::get(getIRType(arrayType->getElementType()));
+    for (ast::FieldDecl *field : getColumnsClass(arrayType)->getFields()) {
+        llvm::LoadInst *value = builder->CreateAlignedLoad(getColumnReference(arrayType, arrayRef, field, index), getAlignment(field->getType()));
+        addAccessTag(value, field->getType());
+        element = builder->CreateInsertValue(element, value, table.getFieldSlot(field));
+    }
+    
+    return element;
+}
+
+llvm::StoreInst *codegen::ModuleBuilder::storeColumns(ast::SubscriptExpr *subscript, llvm::Value *element) {
+    ast::ArrayType *arrayType = llvm::cast<ast::ArrayType>(subscript->getEntity()->evalType()->getCanonicalType());
+    
+    llvm::Value *arrayRef = getOrSpillReference(subscript->getEntity());
+    llvm::Value *index = createCheckedIndex(subscript, builder->getInt64(arrayType->getLength()));
+    
+    // the element is scattered to every column.
+    llvm::StoreInst *store = nullptr;
+    for (ast::FieldDecl *field : getColumnsClass(arrayType)->getFields()) {
+        store = builder->CreateAlignedStore(builder->CreateExtractValue(element, table.getFieldSlot(field)),
+                                            getColumnReference(arrayType, arrayRef, field, index), getAlignment(field->getType()));
+        addAccessTag(store, field->getType());
+    }
+    
+    return store;
+}
+
+void codegen::ModuleBuilder::visitLengthExpr(ast::LengthExpr *length) {
+    ast::Expr *entity = length->getEntity();
+    
+    if (ast::ArrayType *arrayType = llvm::dyn_cast<ast::ArrayType>(entity->evalType()->getCanonicalType())) {
+        if (!llvm::isa<ast::VarRef>(entity)) build(entity); // the entity may have side effects.
+        
+        table.setValForComponent(length, builder->getInt64(arrayType->getLength()));
+        return;
+    }
+    
+    table.setValForComponent(length, builder->CreateExtractValue(build(entity), 1));
+}
@@ -9,14 +9,16 @@
 
 #include <hpc/ir/builders.h>
 #include <hpc/ast/exprs/binary.h>
+#include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/reference.h>
 
 #include <llvm/IR/Value.h>
 
 using namespace hpc;
 
 static bool hasNSW(ast::BinaryExpr &expression) {
-    ast::Type *lhsTy = expression.getLHS()->evalType();
-    ast::Type *rhsTy = expression.getRHS()->evalType();
+    ast::Type *lhsTy = expression.getLHS()->evalType()->getScalarType();
+    ast::Type *rhsTy = expression.getRHS()->evalType()->getScalarType();
     
     return lhsTy->isSignedIntegerType() || rhsTy->isSignedIntegerType(); // FIXME
 }
@@ -26,7 +28,8 @@ void codegen::ModuleBuilder::visitArithmeticExpr(ast::ArithmeticExpr *expression
     llvm::Value *L = build(expression->getLHS());
     llvm::Value *R = build(expression->getRHS());
     
-    ast::Type *type = expression->evalType();
+    ast::Type *type = expression->evalType()->getScalarType();
+    // vectors are operated lane by lane by the same instructions.
     
     bool NUW = false;
     bool NSW = hasNSW(*expression);
@@ -111,7 +114,7 @@ void codegen::ModuleBuilder::visitComparisonExpr(ast::ComparisonExpr *expression
     llvm::Value *L = build(expression->getLHS());
     llvm::Value *R = build(expression->getRHS());
     
-    ast::Type *type = expression->getLHS()->evalType();
+    ast::Type *type = expression->getLHS()->evalType()->getScalarType();
     // LHS and RHS types are equal thanks to the validator.
     
     bool hasSign = hasNSW(*expression);
@@ -209,23 +212,62 @@ void codegen::ModuleBuilder::visitComparisonExpr(ast::ComparisonExpr *expression
 }
 
 void codegen::ModuleBuilder::visitAssignmentExpr(ast::AssignmentExpr *expression) {
-    llvm::Value *R = build(expression->getRHS());
-    
     ast::Type *assignmentType = expression->evalType();
     
+    // the assigned object may be read while the new one is built, so it is not constructed in place.
+    ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(expression->getLHS());
+    if (isObjectType(assignmentType) && !(subscript && subscript->isColumnAccess())) {
+        llvm::Value *reference = table.getOrCreateReference(expression->getLHS());
+        table.setValForComponent(expression, createObjectCopy(expression->getRHS(), reference, getAccessAlignment(expression->getLHS()), false));
+        return;
+    }
+    
+    llvm::Value *R = build(expression->getRHS());
+    
     if (assignmentType->isBooleanType()) {
         R = builder->CreateZExt(R, getIRType(assignmentType));
     }
     
-    table.setValForComponent(expression, builder->CreateStore(R, table.getOrCreateReference(expression->getLHS())));
+    ast::VarRef *varRef = llvm::dyn_cast<ast::VarRef>(expression->getLHS());
+    if (varRef && isSSAVar(varRef->getVar())) {
+        writeVariable(varRef->getVar(), builder->GetInsertBlock(), R);
+        table.setValForComponent(expression, R);
+        return;
+    }
+    
+    // a single lane is assigned by replacing it in the whole vector.
+    if (subscript && subscript->getEntity()->evalType()->isVectorType()) {
+        llvm::Value *vectorRef = table.getOrCreateReference(subscript->getEntity());
+        unsigned alignment = getAccessAlignment(subscript->getEntity());
+        
+        llvm::LoadInst *load = builder->CreateAlignedLoad(vectorRef, alignment);
+        addAccessTag(load, subscript->getEntity());
+        llvm::Value *vector = builder->CreateInsertElement(load, R, createLaneIndex(subscript, load));
+        
+        llvm::StoreInst *store = builder->CreateAlignedStore(vector, vectorRef, alignment);
+        addAccessTag(store, subscript->getEntity());
+        
+        table.setValForComponent(expression, store);
+        return;
+    }
+    
+    if (subscript && subscript->isColumnAccess()) {
+        table.setValForComponent(expression, storeColumns(subscript, R));
+        return;
+    }
+    
+    llvm::StoreInst *store = builder->CreateAlignedStore(R, table.getOrCreateReference(expression->getLHS()), getAccessAlignment(expression->getLHS()));
+    addAccessTag(store, expression->getLHS());
+    
+    table.setValForComponent(expression, store);
 }
 
 void codegen::ModuleBuilder::visitBitwiseExpr(ast::BitwiseExpr *expression) {
     llvm::Value *L = build(expression->getLHS());
     llvm::Value *R = build(expression->getRHS());
     
-    ast::Type *leftHandType = expression->getLHS()->evalType();
-    ast::Type *rightHandType = expression->getRHS()->evalType();
+    ast::Type *leftHandType = expression->getLHS()->evalType()->getScalarType();
+    ast::Type *rightHandType = expression->getRHS()->evalType()->getScalarType();
     
     switch (expression->getOperator()) {
         case lexer::TokenOperatorLeftShift: {
@@ -251,7 +293,7 @@ void codegen::ModuleBuilder::visitBitwiseExpr(ast::BitwiseExpr *expression) {
             return; // TODO operator overloadings
         }
         case lexer::TokenOperatorBitwiseAnd: {
-            if (leftHandType->isIntegerType() && rightHandType->isIntegerType()) {
+            if ((leftHandType->isIntegerType() && rightHandType->isIntegerType()) || leftHandType->isBooleanType()) {
                 table.setValForComponent(expression, builder->CreateAnd(L, R));
                 return;
             }
@@ -259,7 +301,7 @@ void codegen::ModuleBuilder::visitBitwiseExpr(ast::BitwiseExpr *expression) {
             return; // TODO operator overloadings
         }
         case lexer::TokenOperatorBitwiseOr: {
-            if (leftHandType->isIntegerType() && rightHandType->isIntegerType()) {
+            if ((leftHandType->isIntegerType() && rightHandType->isIntegerType()) || leftHandType->isBooleanType()) {
                 table.setValForComponent(expression, builder->CreateOr(L, R));
                 return;
             }
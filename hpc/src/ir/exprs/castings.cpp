@@ -9,6 +9,8 @@
 
 #include <hpc/ir/builders.h>
 #include <hpc/ast/types/builtintype.h>
+#include <hpc/ast/types/vectortype.h>
+#include <hpc/ast/types/arraytype.h>
 #include <hpc/ast/exprs/castings.h>
 #include <hpc/config.h>
 
@@ -16,22 +18,19 @@
 
 using namespace hpc;
 
-void codegen::ModuleBuilder::visitImplicitCastExpr(ast::ImplicitCastExpr *cast) {
-    ast::Expr *val = cast->getExpression();
-    
-    ast::Type *original = val->evalType();
-    ast::Type *destination = cast->evalType();
-    
-    llvm::Value *llval = build(val);
+llvm::Value *codegen::ModuleBuilder::createConversion(llvm::Value *llval, ast::Type *original, ast::Type *destination) {
     llvm::Type *lltype = getIRType(destination);
     
+    // cast instructions operate on vectors lane by lane, so only the lane types are checked.
+    original = original->getScalarType();
+    destination = destination->getScalarType();
+    
     if (original->isIntegerType() && destination->isIntegerType()) {
         if (original->isSignedIntegerType()) {
-            table.setValForComponent(cast, builder->CreateSExtOrTrunc(llval, lltype));
+            return builder->CreateSExtOrTrunc(llval, lltype);
         } else {
-            table.setValForComponent(cast, builder->CreateZExtOrTrunc(llval, lltype));
+            return builder->CreateZExtOrTrunc(llval, lltype);
         }
-        return;
     }
     
     if (original->getFormat() == destination->getFormat()) {
@@ -42,35 +41,64 @@ void codegen::ModuleBuilder::visitImplicitCastExpr(ast::ImplicitCastExpr *cast)
                 ast::BuiltinType *builtinDestination = llvm::cast<ast::BuiltinType>(destination);
                 
                 if (builtinOriginal->getMagnitude() <= builtinDestination->getMagnitude()) {
-                    table.setValForComponent(cast, builder->CreateFPExt(llval, lltype));
+                    return builder->CreateFPExt(llval, lltype);
                 } else {
-                    table.setValForComponent(cast, builder->CreateFPTrunc(llval, lltype));
+                    return builder->CreateFPTrunc(llval, lltype);
                 }
-                return;
             }
             default: break;
         }
     } else {
         if (original->isIntegerType() && destination->isFloatingPointType()) {
             if (original->isSignedIntegerType()) {
-                table.setValForComponent(cast, builder->CreateSIToFP(llval, lltype));
+                return builder->CreateSIToFP(llval, lltype);
             } else {
-                table.setValForComponent(cast, builder->CreateUIToFP(llval, lltype));
+                return builder->CreateUIToFP(llval, lltype);
             }
-            return;
         }
         
         if (original->isFloatingPointType() && destination->isIntegerType()) {
             if (destination->isSignedIntegerType()) {
-                table.setValForComponent(cast, builder->CreateFPToSI(llval, lltype));
+                return builder->CreateFPToSI(llval, lltype);
             } else {
-                table.setValForComponent(cast, builder->CreateFPToUI(llval, lltype));
+                return builder->CreateFPToUI(llval, lltype);
             }
-            return;
         }
     }
     
-    table.setValForComponent(cast, llval); // FIXME
+    return llval; // FIXME
+}
+
+void codegen::ModuleBuilder::visitImplicitCastExpr(ast::ImplicitCastExpr *cast) {
+    ast::Expr *val = cast->getExpression();
+    
+    ast::Type *original = val->evalType();
+    ast::Type *destination = cast->evalType();
+    
+    // an array cast to a slice is referenced by the slice, with its length.
+    ast::ArrayType *arrayType = llvm::dyn_cast<ast::ArrayType>(original->getCanonicalType());
+    if (arrayType && destination->isSliceType()) {
+        llvm::Value *data = builder->CreateInBoundsGEP(getIRType(arrayType), getOrSpillReference(val), { builder->getInt64(0), builder->getInt64(0) });
+        
+        llvm::Value *slice = llvm::UndefValue::get(getIRType(destination));
+        slice = builder->CreateInsertValue(slice, data, 0);
+        slice = builder->CreateInsertValue(slice, builder->getInt64(arrayType->getLength()), 1);
+        
+        table.setValForComponent(cast, slice);
+        return;
+    }
+    
+    llvm::Value *llval = build(val);
+    
+    // a scalar cast to a vector is converted to the lane type, then copied to every lane.
+    ast::VectorType *vectorType = llvm::dyn_cast<ast::VectorType>(destination->getCanonicalType());
+    if (vectorType && !original->isVectorType()) {
+        llval = createConversion(llval, original, vectorType->getElementType());
+        table.setValForComponent(cast, builder->CreateVectorSplat(vectorType->getNumLanes(), llval));
+        return;
+    }
+    
+    table.setValForComponent(cast, createConversion(llval, original, destination));
 }
 
 void codegen::ModuleBuilder::visitEvalExpr(ast::EvalExpr *eval) {
@@ -51,9 +51,7 @@ void codegen::ModuleBuilder::visitBoolLiteral(ast::BoolLiteral *literal) {
 }
 
 void codegen::ModuleBuilder::visitStringLiteral(ast::StringLiteral *literal) {
-    llvm::GlobalVariable *stringConstant = table.getOrCreateStringConstant(literal->getValue());
-    
-    table.setValForComponent(literal, builder->CreateConstInBoundsGEP2_32(stringConstant->getValueType(), stringConstant, 0, 0));
+    table.setValForComponent(literal, table.getOrCreateStringConstant(literal->getValue()));
 }
 
 void codegen::ModuleBuilder::visitNullPointer(ast::NullPointer *nullpointer) {
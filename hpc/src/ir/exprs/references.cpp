@@ -12,26 +12,124 @@
 #include <hpc/ast/exprs/reference.h>
 #include <hpc/ast/exprs/members.h>
 
+#include <llvm/Analysis/ConstantFolding.h>
 #include <llvm/IR/Value.h>
 
 using namespace hpc;
 
+llvm::Constant *codegen::ModuleBuilder::getConstantLoad(llvm::Value *address) {
+    llvm::Constant *constantAddress = llvm::dyn_cast<llvm::Constant>(address);
+    if (!constantAddress) return nullptr;
+    
+    // only the globals marked constant are never written, the others may be changed before the load.
+    return llvm::ConstantFoldLoadFromConstPtr(constantAddress, address->getType()->getPointerElementType(), getDataLayout());
+}
+
 void codegen::ModuleBuilder::visitVarRef(ast::VarRef *varRef) {
-    table.setValForComponent(varRef, builder->CreateLoad(table.getValForComponent(varRef->getVar()))); // FIXME alignment
+    if (isSSAVar(varRef->getVar())) {
+        table.setValForComponent(varRef, readVariable(varRef->getVar(), builder->GetInsertBlock()));
+        return;
+    }
+    
+    llvm::Value *reference = table.getValForComponent(varRef->getVar());
+    if (llvm::Constant *value = getConstantLoad(reference)) {
+        table.setValForComponent(varRef, value);
+        return;
+    }
+    
+    llvm::LoadInst *load = builder->CreateAlignedLoad(reference, getAccessAlignment(varRef));
+    addAccessTag(load, varRef);
+    
+    table.setValForComponent(varRef, load);
 }
 
-void codegen::ModuleBuilder::visitFunctionCall(ast::FunctionCall *functionCall) {
+std::vector<llvm::Value *> codegen::ModuleBuilder::buildCallArgs(ast::FunctionCall *functionCall, llvm::Value *returnSlot, bool copyObjects) {
+    const target::FunctionABIInfo &abiInfo = getFunctionABI(functionCall->getFunctionDecl());
+    
     std::vector<llvm::Value *> builtArgs;
-    for (ast::Expr *param : functionCall->getActualParams()) builtArgs.push_back(build(param));
+    if (returnSlot) builtArgs.push_back(returnSlot);
+    
+    const std::vector<ast::Expr *> &params = functionCall->getActualParams();
+    for (unsigned i = 0; i < params.size(); i++) {
+        switch (abiInfo.argInfos[i].kind) {
+            case target::ABIArgInfo::Direct:
+                builtArgs.push_back(build(params[i]));
+                break;
+                
+            case target::ABIArgInfo::Coerced: {
+                llvm::Type *coercedType = abiInfo.argInfos[i].coercedType;
+                if (llvm::Value *reference = table.getOrCreateReference(params[i])) {
+                    builtArgs.push_back(createCoercedLoad(reference, params[i]->evalType(), getAccessAlignment(params[i]), coercedType));
+                } else {
+                    builtArgs.push_back(createCoercion(build(params[i]), coercedType));
+                }
+                break;
+            }
+                
+            case target::ABIArgInfo::Indirect: {
+                // the callee receives a copy of the object, which is made from its memory unless a field of a packed class misaligns it.
+                ast::Type *paramType = params[i]->evalType();
+                llvm::Value *reference = table.getOrCreateReference(params[i]);
+                if (reference && !copyObjects && getAccessAlignment(params[i]) >= getAlignment(paramType)) {
+                    builtArgs.push_back(reference);
+                } else {
+                    llvm::AllocaInst *temporary = createTemporary(getIRType(paramType), getAlignment(paramType));
+                    createObjectCopy(params[i], temporary, getAlignment(paramType), true);
+                    builtArgs.push_back(temporary);
+                }
+                break;
+            }
+        }
+    }
+    
+    return builtArgs;
+}
+
+llvm::Value *codegen::ModuleBuilder::createCallResult(llvm::CallInst *call, ast::FunctionDecl *callee, llvm::Value *returnSlot) {
+    const target::ABIArgInfo &returnInfo = getFunctionABI(callee).returnInfo;
+    
+    switch (returnInfo.kind) {
+        case target::ABIArgInfo::Direct: return call;
+        case target::ABIArgInfo::Coerced: return createCoercion(call, getIRType(callee->getReturnType()));
+        case target::ABIArgInfo::Indirect: return builder->CreateAlignedLoad(returnSlot, getAlignment(callee->getReturnType()));
+    }
+    
+    return call;
+}
 
+llvm::CallInst *codegen::ModuleBuilder::createCall(ast::FunctionCall *functionCall, llvm::Value *returnSlot) {
     ast::FunctionDecl *prototypeFunction = functionCall->getFunctionDecl();
     
     build(prototypeFunction);
     
     llvm::Function *irPrototype = static_cast<llvm::Function *>(table.getValForComponent(prototypeFunction));
-    table.setValForComponent(functionCall, builder->CreateCall(irPrototype, builtArgs));
+    
+    llvm::CallInst *call = builder->CreateCall(irPrototype, buildCallArgs(functionCall, returnSlot));
+    call->setAttributes(irPrototype->getAttributes());
+    return call;
+}
+
+void codegen::ModuleBuilder::visitFunctionCall(ast::FunctionCall *functionCall) {
+    ast::FunctionDecl *prototypeFunction = functionCall->getFunctionDecl();
+    
+    llvm::Value *returnSlot = nullptr;
+    if (getFunctionABI(prototypeFunction).returnInfo.kind == target::ABIArgInfo::Indirect) {
+        ast::Type *returnType = prototypeFunction->getReturnType();
+        returnSlot = createTemporary(getIRType(returnType), getAlignment(returnType));
+    }
+    
+    table.setValForComponent(functionCall, createCallResult(createCall(functionCall, returnSlot), prototypeFunction, returnSlot));
 }
 
 void codegen::ModuleBuilder::visitFieldRef(ast::FieldRef *fieldRef) {
-    table.setValForComponent(fieldRef, builder->CreateLoad(table.getOrCreateReference(fieldRef))); // FIXME alignment
+    llvm::Value *reference = table.getOrCreateReference(fieldRef);
+    if (llvm::Constant *value = getConstantLoad(reference)) {
+        table.setValForComponent(fieldRef, value);
+        return;
+    }
+    
+    llvm::LoadInst *load = builder->CreateAlignedLoad(reference, getAccessAlignment(fieldRef));
+    addAccessTag(load, fieldRef);
+    
+    table.setValForComponent(fieldRef, load);
 }
@@ -19,7 +19,7 @@ using namespace hpc;
 void codegen::ModuleBuilder::visitArithmeticNegationExpr(ast::ArithmeticNegationExpr *expression) {
     ast::Expr *operand = expression->getOperand();
     
-    ast::Type *operandType = operand->evalType();
+    ast::Type *operandType = operand->evalType()->getScalarType();
     
     if (operandType->isFloatingPointType()) {
         table.setValForComponent(expression, builder->CreateFNeg(build(operand)));
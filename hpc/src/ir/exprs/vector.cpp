@@ -0,0 +1,63 @@
+// => src/ir/exprs/vector.cpp
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#include <hpc/ir/builders.h>
+#include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/shuffle.h>
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Value.h>
+
+using namespace hpc;
+
+void codegen::ModuleBuilder::visitSubscriptExpr(ast::SubscriptExpr *subscript) {
+    if (subscript->isColumnAccess()) {
+        table.setValForComponent(subscript, loadColumns(subscript));
+        return;
+    }
+    
+    if (!subscript->getEntity()->evalType()->isVectorType()) {
+        llvm::Value *reference = getElementReference(subscript);
+        if (llvm::Constant *value = getConstantLoad(reference)) {
+            table.setValForComponent(subscript, value);
+            return;
+        }
+        
+        llvm::LoadInst *load = builder->CreateAlignedLoad(reference, getAccessAlignment(subscript));
+        addAccessTag(load, subscript);
+        
+        table.setValForComponent(subscript, load);
+        return;
+    }
+    
+    llvm::Value *vector = build(subscript->getEntity());
+    
+    table.setValForComponent(subscript, builder->CreateExtractElement(vector, createLaneIndex(subscript, vector)));
+}
+
+llvm::Value *codegen::ModuleBuilder::createLaneIndex(ast::SubscriptExpr *subscript, llvm::Value *vector) {
+    unsigned lanes = vector->getType()->getVectorNumElements();
+    llvm::Value *index = createCheckedIndex(subscript, builder->getInt64(lanes));
+    
+    // a lane out of the vector makes insertelement and extractelement poison, so unchecked indexes wrap around instead.
+    if (!boundsChecks && !llvm::isa<llvm::Constant>(index)) {
+        index = builder->CreateURem(index, builder->getInt64(lanes));
+    }
+    return index;
+}
+
+void codegen::ModuleBuilder::visitShuffleExpr(ast::ShuffleExpr *shuffle) {
+    llvm::Value *V1 = build(shuffle->getFirstVector());
+    llvm::Value *V2 = shuffle->getSecondVector() ? build(shuffle->getSecondVector()) : llvm::UndefValue::get(V1->getType());
+    
+    const std::vector<unsigned> &mask = shuffle->getMask();
+    std::vector<uint32_t> intMask(mask.begin(), mask.end());
+    
+    table.setValForComponent(shuffle, builder->CreateShuffleVector(V1, V2, intMask));
+}
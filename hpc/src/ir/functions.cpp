@@ -10,11 +10,48 @@
 #include <hpc/ir/builders.h>
 #include <hpc/ast/decls/function.h>
 #include <hpc/ast/types/builtintype.h>
+#include <hpc/runtime/library.h>
 
+#include <llvm/IR/DataLayout.h>
 #include <llvm/IR/Value.h>
 
+#include <algorithm>
+
 using namespace hpc;
 
+const target::FunctionABIInfo &codegen::ModuleBuilder::getFunctionABI(ast::FunctionDecl *function) {
+    auto found = functionABIs.find(function);
+    if (found != functionABIs.end()) return found->second;
+    
+    std::vector<llvm::Type *> paramTypes;
+    for (ast::ParamVar *arg : function->getArgs()) paramTypes.push_back(getIRType(arg->getType()));
+    
+    return functionABIs[function] = getTargetInfo().getTargetABI().classifyFunction(getIRType(function->getReturnType()), paramTypes, getDataLayout());
+}
+
+llvm::Value *codegen::ModuleBuilder::createCoercion(llvm::Value *value, llvm::Type *destination) {
+    llvm::DataLayout &dataLayout = getDataLayout();
+    llvm::Type *source = value->getType();
+    
+    // the temporary holds both representations, so that neither the store nor the load goes out of it.
+    llvm::Type *largest = dataLayout.getTypeAllocSize(source) >= dataLayout.getTypeAllocSize(destination) ? source : destination;
+    unsigned alignment = std::max(dataLayout.getABITypeAlignment(source), dataLayout.getABITypeAlignment(destination));
+    llvm::AllocaInst *temporary = createTemporary(largest, alignment);
+    
+    builder->CreateAlignedStore(value, builder->CreateBitCast(temporary, source->getPointerTo()), alignment);
+    return builder->CreateAlignedLoad(builder->CreateBitCast(temporary, destination->getPointerTo()), alignment);
+}
+
+llvm::Value *codegen::ModuleBuilder::createCoercedLoad(llvm::Value *reference, ast::Type *type, unsigned alignment, llvm::Type *coercedType) {
+    llvm::DataLayout &dataLayout = getDataLayout();
+    
+    if (dataLayout.getTypeStoreSize(coercedType) <= dataLayout.getTypeAllocSize(getIRType(type))) {
+        return builder->CreateAlignedLoad(builder->CreateBitCast(reference, coercedType->getPointerTo()), alignment);
+    }
+    
+    return createCoercion(builder->CreateAlignedLoad(reference, alignment), coercedType);
+}
+
 void codegen::ModuleBuilder::visitFunctionDecl(ast::FunctionDecl *function) {
     if (!table.getValForComponent(function)) {
         llvm::Module &module = getModule();
@@ -23,66 +60,138 @@ void codegen::ModuleBuilder::visitFunctionDecl(ast::FunctionDecl *function) {
         std::vector<llvm::Type *> argtypes;
         
         ast::Type *returnType = function->getReturnType();
+        llvm::Type *irReturnType = getIRType(returnType);
+        
+        // an object returned in memory is stored by the callee at the address given by the caller in a hidden first argument.
+        const target::FunctionABIInfo &abiInfo = getFunctionABI(function);
+        bool hasReturnSlot = abiInfo.returnInfo.kind == target::ABIArgInfo::Indirect;
+        unsigned firstArg = hasReturnSlot ? 1 : 0;
+        
+        if (hasReturnSlot) {
+            argtypes.push_back(irReturnType->getPointerTo());
+            irReturnType = llvm::Type::getVoidTy(module.getContext());
+        } else if (abiInfo.returnInfo.kind == target::ABIArgInfo::Coerced) {
+            irReturnType = abiInfo.returnInfo.coercedType;
+        }
         
-        for (ast::ParamVar *arg : arguments) {
-            llvm::Type *llty = getIRType(arg->getType());
-            // TODO zeroext, signext
-            argtypes.push_back(llty);
+        for (unsigned i = 0; i < arguments.size(); i++) {
+            llvm::Type *llty = getIRType(arguments[i]->getType());
+            
+            switch (abiInfo.argInfos[i].kind) {
+                case target::ABIArgInfo::Direct: argtypes.push_back(llty); break;
+                case target::ABIArgInfo::Coerced: argtypes.push_back(abiInfo.argInfos[i].coercedType); break;
+                case target::ABIArgInfo::Indirect: argtypes.push_back(llty->getPointerTo()); break;
+            }
         }
         
         
-        llvm::Function *irfunc = llvm::Function::Create(llvm::FunctionType::get(getIRType(returnType), argtypes, false),
+        llvm::Function *irfunc = llvm::Function::Create(llvm::FunctionType::get(irReturnType, argtypes, false),
                                                         llvm::GlobalValue::ExternalLinkage,
                                                         getTargetInfo().getMangle().mangleFunction(function),
                                                         &module);
         
-        unsigned i = 0;
-        for (auto &arg : irfunc->args()) {
-            ast::Type *paramty = arguments[i++]->getType();
+        std::vector<llvm::Argument *> irArgs;
+        for (auto &arg : irfunc->args()) irArgs.push_back(&arg);
+        
+        if (hasReturnSlot) {
+            irfunc->addAttribute(1, llvm::Attribute::StructRet);
+            irfunc->addAttribute(1, llvm::Attribute::NoAlias);
+        }
+        
+        for (unsigned i = 0; i < arguments.size(); i++) {
+            ast::Type *paramty = arguments[i]->getType();
+            unsigned index = firstArg + i + 1;
+            
+            // the caller passes the address of a copy of the object, with the alignment of its class.
+            if (abiInfo.argInfos[i].kind == target::ABIArgInfo::Indirect) {
+                irfunc->addAttribute(index, llvm::Attribute::ByVal);
+                irfunc->addAttribute(index, llvm::Attribute::getWithAlignment(module.getContext(), getAlignment(paramty)));
+            }
             
             if (paramty->isSignedIntegerType()) {
-                irfunc->addAttribute(arg.getArgNo()+1, llvm::Attribute::SExt);
+                irfunc->addAttribute(index, llvm::Attribute::SExt);
             }
             
             if (paramty->isUnsignedIntegerType()) {
-                irfunc->addAttribute(arg.getArgNo()+1, llvm::Attribute::ZExt);
+                irfunc->addAttribute(index, llvm::Attribute::ZExt);
             }
             // FIXME This is not necessary for too large integer types (typically 32+ bits).
             
+            if (paramty->isExclusive() && paramty->isPointerType()) {
+                irfunc->addAttribute(index, llvm::Attribute::NoAlias);
+            }
+            
         }
         
         table.setValForComponent(function, irfunc);
         if (ast::CompoundStmt *statementsBlock = function->getStatementsBlock()) {
-            unsigned i = 0;
-            for (auto &arg : irfunc->args()) {
-                arg.setName(arguments[i++]->getName());
+            if (hasReturnSlot) irArgs[0]->setName("agg.result");
+            for (unsigned i = 0; i < arguments.size(); i++) {
+                irArgs[firstArg + i]->setName(arguments[i]->getName());
             }
             
             llvm::BasicBlock *mainBlock = llvm::BasicBlock::Create(module.getContext(), "", irfunc);
             
+            // a callee may be built in the middle of the body of its caller, which is resumed once the callee is done.
+            FunctionState callerState = suspendFunction();
             builder = new InstructionBuilder(module.getContext());
             builder->SetInsertPoint(mainBlock);
+            table.pushFunction();
+            createAliasScopes(function);
+            beginSSA(function);
             
             if (function->containedReturns() > 1) {
                 returnBlock = llvm::BasicBlock::Create(module.getContext(), "");
-                if (!returnType->isVoidType()) {
-                    returnRegister = builder->CreateAlloca(getIRType(returnType));
-                    //returnRegister->setAlignment(rtype->getType()->getAlignment());
+                if (hasReturnSlot) {
+                    returnRegister = irArgs[0];
+                } else if (!returnType->isVoidType()) {
+                    llvm::AllocaInst *returnAlloca = builder->CreateAlloca(getIRType(returnType));
+                    returnAlloca->setAlignment(getAlignment(returnType));
+                    returnRegister = returnAlloca;
                 }
             }
             
-            for (ast::ParamVar *arg : arguments) {
-                table.setValForComponent(arg, builder->CreateAlloca(getIRType(arg->getType())));
-                // FIXME alignment
+            for (unsigned i = 0; i < arguments.size(); i++) {
+                // the copy made by the caller is the storage of an object passed in memory.
+                if (abiInfo.argInfos[i].kind == target::ABIArgInfo::Indirect) {
+                    table.setValForComponent(arguments[i], irArgs[firstArg + i]);
+                    continue;
+                }
+                if (isSSAVar(arguments[i])) continue;
+                
+                llvm::AllocaInst *argAlloca = builder->CreateAlloca(getIRType(arguments[i]->getType()));
+                argAlloca->setAlignment(getAlignment(arguments[i]->getType()));
+                table.setValForComponent(arguments[i], argAlloca);
             }
             
             for (ast::Var *localVar : function->getLocalVars()) {
-                table.setValForComponent(localVar, builder->CreateAlloca(getIRType(localVar->getType()), nullptr, localVar->getName()));
-                // FIXME alignment
+                if (isSSAVar(localVar)) continue;
+                
+                llvm::AllocaInst *localAlloca = builder->CreateAlloca(getIRType(localVar->getType()), nullptr, localVar->getName());
+                localAlloca->setAlignment(getAlignment(localVar->getType()));
+                table.setValForComponent(localVar, localAlloca);
             }
             
-            i = 0;
-            for (auto &arg : irfunc->args()) assign(arguments[i++], &arg);
+            for (unsigned i = 0; i < arguments.size(); i++) {
+                llvm::Value *arg = irArgs[firstArg + i];
+                
+                switch (abiInfo.argInfos[i].kind) {
+                    case target::ABIArgInfo::Direct: assign(arguments[i], arg); break;
+                    case target::ABIArgInfo::Indirect: break;
+                        
+                    case target::ABIArgInfo::Coerced: {
+                        // the registers are stored straight to the parameter, unless they hold more bytes than the object.
+                        llvm::Type *irType = getIRType(arguments[i]->getType());
+                        if (getDataLayout().getTypeStoreSize(arg->getType()) <= getDataLayout().getTypeAllocSize(irType)) {
+                            llvm::Value *reference = builder->CreateBitCast(table.getValForComponent(arguments[i]), arg->getType()->getPointerTo());
+                            builder->CreateAlignedStore(arg, reference, getAlignment(arguments[i]->getType()));
+                        } else {
+                            assign(arguments[i], createCoercion(arg, irType));
+                        }
+                        break;
+                    }
+                }
+            }
             for (ast::Stmt *stmt : statementsBlock->statements()) takeStmt(stmt);
             
             bool nrets = !statementsBlock->returns();
@@ -92,16 +201,23 @@ void codegen::ModuleBuilder::visitFunctionDecl(ast::FunctionDecl *function) {
                 irfunc->getBasicBlockList().push_back(returnBlock);
                 builder->SetInsertPoint(returnBlock);
                 
-                if (!returnType->isVoidType()) {
-                    builder->CreateRet(builder->CreateLoad(returnRegister)); // FIXME alignment
-                } else {
+                if (hasReturnSlot || returnType->isVoidType()) {
                     builder->CreateRetVoid();
+                } else if (abiInfo.returnInfo.kind == target::ABIArgInfo::Coerced) {
+                    builder->CreateRet(createCoercedLoad(returnRegister, returnType, getAlignment(returnType), abiInfo.returnInfo.coercedType));
+                } else {
+                    builder->CreateRet(builder->CreateAlignedLoad(returnRegister, getAlignment(returnType)));
                 }
             } else if (nrets && returnType->isVoidType()) {
                 builder->CreateRetVoid();
             }
             
-            builder = nullptr;
+            endSSA(irfunc);
+            
+            // the values of the parameters, the local variables and the expressions are only used in the body.
+            table.popFunction();
+            delete builder;
+            resumeFunction(callerState);
         }
         
         //if(function.isExceptionSafe())
@@ -109,6 +225,39 @@ void codegen::ModuleBuilder::visitFunctionDecl(ast::FunctionDecl *function) {
         irfunc->addFnAttr(llvm::Attribute::StackProtect);
         irfunc->addFnAttr(llvm::Attribute::UWTable);
         
+        // the semantics of the runtime library functions are known, even though they are defined outside the program.
+        if (!function->getStatementsBlock()) runtime::addRuntimeAttributes(*irfunc);
+        
+        // the paths calling a cold function are expected not to be taken, and its code is kept apart from the hot text.
+        if (function->isRarelyCalled()) {
+            irfunc->addFnAttr(llvm::Attribute::Cold);
+            irfunc->addFnAttr(llvm::Attribute::OptimizeForSize);
+            irfunc->setSectionPrefix(".unlikely");
+        }
+        
+        if (purity) {
+            // the memory of the return slot and of the objects passed in memory is only reachable through the arguments.
+            bool hasIndirectArgs = std::any_of(abiInfo.argInfos.begin(), abiInfo.argInfos.end(), [](const target::ABIArgInfo &argInfo) {
+                return argInfo.kind == target::ABIArgInfo::Indirect;
+            });
+            
+            if (purity->isReadNone(function)) {
+                irfunc->addFnAttr(hasReturnSlot || hasIndirectArgs ? llvm::Attribute::ArgMemOnly : llvm::Attribute::ReadNone);
+            } else if (purity->isReadOnly(function) && !hasReturnSlot && !(hasIndirectArgs && purity->writesObjectArgs(function))) {
+                // writing the copy of an object passed in memory is still a write, which readonly does not allow.
+                irfunc->addFnAttr(llvm::Attribute::ReadOnly);
+            }
+            
+            if (purity->isNoRecurse(function)) irfunc->addFnAttr(llvm::Attribute::NoRecurse);
+            
+            for (unsigned i = 0; i < arguments.size(); i++) {
+                if (purity->isNoCapture(function, i)) {
+                    irfunc->addAttribute(firstArg + i + 1, llvm::Attribute::NoCapture);
+                }
+            }
+            if (hasReturnSlot) irfunc->addAttribute(1, llvm::Attribute::NoCapture);
+        }
+        
         //assert(llvm::verifyFunction(&irfunc, &llvm::errs()) && "Function verification failed.");
     }
 }
@@ -15,8 +15,6 @@
 
 using namespace hpc;
 
-static llvm::LLVMContext context;
-
 modules::ModuleWrapper::ModuleWrapper(std::string modulename) {
     module = new llvm::Module(modulename, context);
 }
@@ -19,7 +19,8 @@ using namespace hpc;
 void codegen::ModuleBuilder::visitUnit(ast::CompilationUnit &unit) {
     
     for (ast::Decl *decl : unit.getTopLevelDeclarations()) {
-        takeDecl(decl);
+        if (shouldBuild(decl)) takeDecl(decl);
     }
-
+    
+    finalizeGlobalInit();
 }
@@ -0,0 +1,145 @@
+// => src/ir/ssa.cpp
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#include <hpc/ir/builders.h>
+#include <hpc/ast/decls/function.h>
+#include <hpc/ast/types/base.h>
+#include <hpc/ast/types/builtintype.h>
+
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Instructions.h>
+
+using namespace hpc;
+
+/*!
+ \brief Returns whether the variables of the given type hold a single scalar, which is never accessed through its address.
+ \note Vectors are excluded, since their lanes are assigned through the address of the whole vector.
+ */
+static bool isRegisterType(ast::Type *type) {
+    type = type->getCanonicalType();
+    if (ast::QualifiedType *qualType = llvm::dyn_cast<ast::QualifiedType>(type)) type = qualType->getEnclosingType()->getCanonicalType();
+    
+    return (llvm::isa<ast::BuiltinType>(type) && !type->isVoidType()) || type->isPointerType();
+}
+
+void codegen::ModuleBuilder::beginSSA(ast::FunctionDecl *function) {
+    ssaDefinitions.clear();
+    sealedBlocks.clear();
+    incompletePhis.clear();
+    
+    if (!directSSA) return;
+    
+    // the entry block has no predecessor.
+    sealBlock(builder->GetInsertBlock());
+    
+    for (ast::ParamVar *arg : function->getArgs()) {
+        if (isRegisterType(arg->getType())) ssaDefinitions[arg];
+    }
+    for (ast::Var *localVar : function->getLocalVars()) {
+        if (isRegisterType(localVar->getType())) ssaDefinitions[localVar];
+    }
+}
+
+void codegen::ModuleBuilder::endSSA(llvm::Function *irfunc) {
+    // the blocks no statement sealed, like the trap block, get all their predecessors once the function is built.
+    for (llvm::BasicBlock &block : *irfunc) sealBlock(&block);
+    
+    ssaDefinitions.clear();
+    sealedBlocks.clear();
+    incompletePhis.clear();
+}
+
+void codegen::ModuleBuilder::writeVariable(ast::Var *var, llvm::BasicBlock *block, llvm::Value *value) {
+    ssaDefinitions[var][block] = value;
+}
+
+llvm::Value *codegen::ModuleBuilder::readVariable(ast::Var *var, llvm::BasicBlock *block) {
+    std::map<llvm::BasicBlock *, llvm::WeakTrackingVH> &definitions = ssaDefinitions[var];
+    
+    auto definition = definitions.find(block);
+    if (definition != definitions.end() && definition->second) return definition->second;
+    
+    llvm::Type *type = getIRType(var->getType());
+    llvm::Value *value;
+    
+    if (!sealedBlocks.count(block)) {
+        // the operands are added once all the predecessors are known.
+        llvm::PHINode *phi = createPhi(type, block);
+        incompletePhis[block].push_back(std::make_pair(var, phi));
+        value = phi;
+    } else if (llvm::BasicBlock *predecessor = block->getSinglePredecessor()) {
+        value = readVariable(var, predecessor);
+    } else if (llvm::pred_begin(block) == llvm::pred_end(block)) {
+        value = llvm::UndefValue::get(type); // the block is unreachable.
+    } else {
+        // the phi is defined before reading the predecessors, so that the cycles of the loops end on it.
+        llvm::PHINode *phi = createPhi(type, block);
+        writeVariable(var, block, phi);
+        value = addPhiOperands(var, phi);
+    }
+    
+    writeVariable(var, block, value);
+    return value;
+}
+
+llvm::PHINode *codegen::ModuleBuilder::createPhi(llvm::Type *type, llvm::BasicBlock *block) {
+    if (block->empty()) return llvm::PHINode::Create(type, 0, "", block);
+    return llvm::PHINode::Create(type, 0, "", &block->front());
+}
+
+llvm::Value *codegen::ModuleBuilder::addPhiOperands(ast::Var *var, llvm::PHINode *phi) {
+    llvm::BasicBlock *block = phi->getParent();
+    for (llvm::BasicBlock *predecessor : llvm::predecessors(block)) {
+        phi->addIncoming(readVariable(var, predecessor), predecessor);
+    }
+    
+    return tryRemoveTrivialPhi(phi);
+}
+
+llvm::Value *codegen::ModuleBuilder::tryRemoveTrivialPhi(llvm::PHINode *phi) {
+    llvm::Value *same = nullptr;
+    for (llvm::Value *operand : phi->incoming_values()) {
+        if (operand == same || operand == phi) continue;
+        if (same) return phi; // the phi merges at least two values.
+        
+        same = operand;
+    }
+    
+    // a phi only referencing itself is in a block unreachable from the entry block.
+    if (!same) same = llvm::UndefValue::get(phi->getType());
+    
+    // the other phis using this one may become trivial once it is replaced.
+    std::vector<llvm::WeakTrackingVH> users;
+    for (llvm::User *user : phi->users()) {
+        if (user != phi && llvm::isa<llvm::PHINode>(user)) users.push_back(user);
+    }
+    
+    phi->replaceAllUsesWith(same);
+    phi->eraseFromParent();
+    
+    for (llvm::WeakTrackingVH &user : users) {
+        if (llvm::PHINode *userPhi = llvm::dyn_cast_or_null<llvm::PHINode>(user)) tryRemoveTrivialPhi(userPhi);
+    }
+    
+    return same;
+}
+
+void codegen::ModuleBuilder::sealBlock(llvm::BasicBlock *block) {
+    if (!directSSA || sealedBlocks.count(block)) return;
+    
+    // reading the predecessors may add incomplete phis to this block, which are completed in the same loop.
+    for (size_t i = 0; i < incompletePhis[block].size(); i++) {
+        std::pair<ast::Var *, llvm::PHINode *> incomplete = incompletePhis[block][i];
+        addPhiOperands(incomplete.first, incomplete.second);
+    }
+    
+    incompletePhis.erase(block);
+    sealedBlocks.insert(block);
+}
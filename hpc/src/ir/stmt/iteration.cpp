@@ -11,10 +11,67 @@
 #include <hpc/ast/stmt/whileuntil.h>
 #include <hpc/ast/stmt/for.h>
 
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/Metadata.h>
 #include <llvm/IR/Value.h>
 
 using namespace hpc;
 
+void codegen::ModuleBuilder::addLoopDirectives(ast::SimpleIterStmt *statement, llvm::BasicBlock *header, llvm::BasicBlock *exit) {
+    const ast::LoopDirectives &directives = statement->getDirectives();
+    if (directives.empty()) return;
+    
+    llvm::LLVMContext &context = builder->getContext();
+    
+    std::vector<llvm::Metadata *> operands;
+    auto addProperty = [&](const char *name, llvm::Value *value) {
+        std::vector<llvm::Metadata *> property = { llvm::MDString::get(context, name) };
+        if (value) property.push_back(llvm::ConstantAsMetadata::get(llvm::cast<llvm::Constant>(value)));
+        operands.push_back(llvm::MDNode::get(context, property));
+    };
+    
+    // the loop ID refers to itself, so that the IDs of different loops are never uniqued together.
+    auto placeholder = llvm::MDNode::getTemporary(context, llvm::None);
+    operands.push_back(placeholder.get());
+    
+    if (directives.vectorize) {
+        addProperty("llvm.loop.vectorize.enable", builder->getTrue());
+        if (directives.vectorizeWidth) addProperty("llvm.loop.vectorize.width", builder->getInt32(directives.vectorizeWidth));
+    }
+    if (directives.interleaveCount) addProperty("llvm.loop.interleave.count", builder->getInt32(directives.interleaveCount));
+    if (directives.unrollFully) addProperty("llvm.loop.unroll.full", nullptr);
+    else if (directives.unrollCount) addProperty("llvm.loop.unroll.count", builder->getInt32(directives.unrollCount));
+    else if (directives.unroll) addProperty("llvm.loop.unroll.enable", nullptr);
+    
+    llvm::MDNode *loopID = llvm::MDNode::get(context, operands);
+    loopID->replaceOperandWith(0, loopID);
+    
+    for (auto block = header->getIterator(); &*block != exit; ++block) {
+        if (!block->getTerminator()) continue;
+        
+        // the loop optimizers read the ID from every latch, including the ones of the continue statements.
+        for (llvm::BasicBlock *successor : llvm::successors(&*block)) {
+            if (successor == header) {
+                block->getTerminator()->setMetadata(llvm::LLVMContext::MD_loop, loopID);
+                break;
+            }
+        }
+        
+        if (!directives.independent) continue;
+        
+        // the vectorizer ignores the memory dependencies of a loop only when all its accesses are tagged, including the ones of nested loops.
+        for (llvm::Instruction &instruction : *block) {
+            if (!instruction.mayReadOrWriteMemory()) continue;
+            
+            llvm::MDNode *loops = llvm::MDNode::get(context, loopID);
+            if (llvm::MDNode *nestedLoops = instruction.getMetadata(llvm::LLVMContext::MD_mem_parallel_loop_access)) {
+                loops = llvm::MDNode::concatenate(nestedLoops, loops);
+            }
+            instruction.setMetadata(llvm::LLVMContext::MD_mem_parallel_loop_access, loops);
+        }
+    }
+}
+
 void codegen::ModuleBuilder::visitPreWhileStmt(ast::PreWhileStmt *statement) {
     llvm::Function *irfunc = builder->GetInsertBlock()->getParent();
     
@@ -22,12 +79,17 @@ void codegen::ModuleBuilder::visitPreWhileStmt(ast::PreWhileStmt *statement) {
     llvm::BasicBlock *iterationBlock = llvm::BasicBlock::Create(builder->getContext());
     llvm::BasicBlock *remergeBlock = llvm::BasicBlock::Create(builder->getContext());
     
+    // the blocks are known before the body is built, since its break and continue statements branch to them.
+    table.setBreakBlock(*statement, remergeBlock);
+    table.setContinueBlock(*statement, conditionBlock);
+    
     builder->CreateBr(conditionBlock);
     irfunc->getBasicBlockList().push_back(conditionBlock);
     
     builder->SetInsertPoint(conditionBlock);
     builder->CreateCondBr(build(statement->getCondition()), iterationBlock, remergeBlock);
     irfunc->getBasicBlockList().push_back(iterationBlock);
+    sealBlock(iterationBlock);
     
     
     builder->SetInsertPoint(iterationBlock);
@@ -36,11 +98,14 @@ void codegen::ModuleBuilder::visitPreWhileStmt(ast::PreWhileStmt *statement) {
     }
     builder->CreateTerminatorIfNeeded(conditionBlock);
     
+    // the back edges and the break statements are known once the body is built.
+    sealBlock(conditionBlock);
+    sealBlock(remergeBlock);
+    
     irfunc->getBasicBlockList().push_back(remergeBlock);
     builder->SetInsertPoint(remergeBlock);
     
-    table.setBreakBlock(*statement, remergeBlock);
-    table.setContinueBlock(*statement, conditionBlock);
+    addLoopDirectives(statement, conditionBlock, remergeBlock);
 }
 
 void codegen::ModuleBuilder::visitPreUntilStmt(ast::PreUntilStmt *statement) {
@@ -50,12 +115,17 @@ void codegen::ModuleBuilder::visitPreUntilStmt(ast::PreUntilStmt *statement) {
     llvm::BasicBlock *iterationBlock = llvm::BasicBlock::Create(builder->getContext());
     llvm::BasicBlock *remergeBlock = llvm::BasicBlock::Create(builder->getContext());
     
+    // the blocks are known before the body is built, since its break and continue statements branch to them.
+    table.setBreakBlock(*statement, remergeBlock);
+    table.setContinueBlock(*statement, conditionBlock);
+    
     builder->CreateBr(conditionBlock);
     irfunc->getBasicBlockList().push_back(conditionBlock);
     
     builder->SetInsertPoint(conditionBlock);
     builder->CreateCondBr(build(statement->getCondition()), remergeBlock, iterationBlock);
     irfunc->getBasicBlockList().push_back(iterationBlock);
+    sealBlock(iterationBlock);
     
     
     builder->SetInsertPoint(iterationBlock);
@@ -64,11 +134,14 @@ void codegen::ModuleBuilder::visitPreUntilStmt(ast::PreUntilStmt *statement) {
     }
     builder->CreateTerminatorIfNeeded(conditionBlock);
     
+    // the back edges and the break statements are known once the body is built.
+    sealBlock(conditionBlock);
+    sealBlock(remergeBlock);
+    
     irfunc->getBasicBlockList().push_back(remergeBlock);
     builder->SetInsertPoint(remergeBlock);
     
-    table.setBreakBlock(*statement, remergeBlock);
-    table.setContinueBlock(*statement, conditionBlock);
+    addLoopDirectives(statement, conditionBlock, remergeBlock);
 }
 
 void codegen::ModuleBuilder::visitPostWhileStmt(ast::PostWhileStmt *statement) {
@@ -78,6 +151,10 @@ void codegen::ModuleBuilder::visitPostWhileStmt(ast::PostWhileStmt *statement) {
     llvm::BasicBlock *conditionBlock = llvm::BasicBlock::Create(builder->getContext());
     llvm::BasicBlock *remergeBlock = llvm::BasicBlock::Create(builder->getContext());
     
+    // the blocks are known before the body is built, since its break and continue statements branch to them.
+    table.setBreakBlock(*statement, remergeBlock);
+    table.setContinueBlock(*statement, conditionBlock);
+    
     builder->CreateBr(iterationBlock);
     irfunc->getBasicBlockList().push_back(iterationBlock);
     
@@ -87,15 +164,17 @@ void codegen::ModuleBuilder::visitPostWhileStmt(ast::PostWhileStmt *statement) {
     }
     builder->CreateTerminatorIfNeeded(conditionBlock);
     irfunc->getBasicBlockList().push_back(conditionBlock);
+    sealBlock(conditionBlock);
     
     builder->SetInsertPoint(conditionBlock);
     builder->CreateCondBr(build(statement->getCondition()), iterationBlock, remergeBlock);
+    sealBlock(iterationBlock);
+    sealBlock(remergeBlock);
     
     irfunc->getBasicBlockList().push_back(remergeBlock);
     builder->SetInsertPoint(remergeBlock);
     
-    table.setBreakBlock(*statement, remergeBlock);
-    table.setContinueBlock(*statement, conditionBlock);
+    addLoopDirectives(statement, iterationBlock, remergeBlock);
 }
 
 void codegen::ModuleBuilder::visitPostUntilStmt(ast::PostUntilStmt *statement) {
@@ -105,6 +184,10 @@ void codegen::ModuleBuilder::visitPostUntilStmt(ast::PostUntilStmt *statement) {
     llvm::BasicBlock *conditionBlock = llvm::BasicBlock::Create(builder->getContext());
     llvm::BasicBlock *remergeBlock = llvm::BasicBlock::Create(builder->getContext());
     
+    // the blocks are known before the body is built, since its break and continue statements branch to them.
+    table.setBreakBlock(*statement, remergeBlock);
+    table.setContinueBlock(*statement, conditionBlock);
+    
     builder->CreateBr(iterationBlock);
     irfunc->getBasicBlockList().push_back(iterationBlock);
     
@@ -114,49 +197,77 @@ void codegen::ModuleBuilder::visitPostUntilStmt(ast::PostUntilStmt *statement) {
     }
     builder->CreateTerminatorIfNeeded(conditionBlock);
     irfunc->getBasicBlockList().push_back(conditionBlock);
+    sealBlock(conditionBlock);
     
     builder->SetInsertPoint(conditionBlock);
     builder->CreateCondBr(build(statement->getCondition()), remergeBlock, iterationBlock);
+    sealBlock(iterationBlock);
+    sealBlock(remergeBlock);
     
     irfunc->getBasicBlockList().push_back(remergeBlock);
     builder->SetInsertPoint(remergeBlock);
     
-    table.setBreakBlock(*statement, remergeBlock);
-    table.setContinueBlock(*statement, conditionBlock);
+    addLoopDirectives(statement, iterationBlock, remergeBlock);
 }
 
 void codegen::ModuleBuilder::visitForStmt(ast::ForStmt *statement) {
     for (ast::Stmt *initStmt : statement->getInitStatements()) build(initStmt);
     
+    // the accesses made with the induction variable are checked once, against the last index the loop reaches.
+    if (const bounds::InductionRange *range = boundsChecks && boundsCheckAnalysis ? boundsCheckAnalysis->getInductionRange(statement) : nullptr) {
+        llvm::Value *upperBound = createIndex(build(range->upperBound), range->upperBound->evalType());
+        llvm::Value *end = range->inclusive ? builder->CreateAdd(upperBound, builder->getInt64(1)) : upperBound;
+        llvm::Value *iterates = builder->CreateICmpSLT(builder->getInt64(range->lowerBound), end);
+        
+        for (const bounds::HoistedCheck &check : boundsCheckAnalysis->getHoistedChecks(statement)) {
+            llvm::Value *length = builder->getInt64(check.arrayLength);
+            if (check.slice) {
+                llvm::Value *slice = builder->CreateAlignedLoad(table.getValForComponent(check.slice), getAlignment(check.slice->getType()));
+                length = builder->CreateExtractValue(slice, 1);
+            }
+            
+            createBoundsCheck(builder->CreateNot(builder->CreateAnd(iterates, builder->CreateICmpUGT(end, length))));
+        }
+    }
+    
     llvm::Function *irfunc = builder->GetInsertBlock()->getParent();
     
     llvm::BasicBlock *conditionBlock = llvm::BasicBlock::Create(builder->getContext());
     llvm::BasicBlock *iterationBlock = llvm::BasicBlock::Create(builder->getContext());
+    llvm::BasicBlock *endBlock = llvm::BasicBlock::Create(builder->getContext());
     llvm::BasicBlock *remergeBlock = llvm::BasicBlock::Create(builder->getContext());
     
+    // the blocks are known before the body is built, since its break and continue statements branch to them.
+    // A continue statement runs the end statements before the condition is evaluated again.
+    table.setBreakBlock(*statement, remergeBlock);
+    table.setContinueBlock(*statement, endBlock);
+    
     builder->CreateBr(conditionBlock);
     irfunc->getBasicBlockList().push_back(conditionBlock);
     
     builder->SetInsertPoint(conditionBlock);
     builder->CreateCondBr(build(statement->getCondition()), iterationBlock, remergeBlock);
     irfunc->getBasicBlockList().push_back(iterationBlock);
+    sealBlock(iterationBlock);
     
     builder->SetInsertPoint(iterationBlock);
     if (ast::Stmt *block = statement->getBlock()) {
         build(block);
     }
     
-    llvm::BasicBlock *endBlock = llvm::BasicBlock::Create(builder->getContext());
-    
     builder->CreateTerminatorIfNeeded(endBlock);
     irfunc->getBasicBlockList().push_back(endBlock);
+    sealBlock(endBlock);
     builder->SetInsertPoint(endBlock);
     for (ast::Stmt *endStmt : statement->getEndStatements()) build(endStmt);
     builder->CreateTerminatorIfNeeded(conditionBlock);
     
+    // the back edges and the break statements are known once the body is built.
+    sealBlock(conditionBlock);
+    sealBlock(remergeBlock);
+    
     irfunc->getBasicBlockList().push_back(remergeBlock);
     builder->SetInsertPoint(remergeBlock);
     
-    table.setBreakBlock(*statement, remergeBlock);
-    table.setContinueBlock(*statement, endBlock);
+    addLoopDirectives(statement, conditionBlock, remergeBlock);
 }
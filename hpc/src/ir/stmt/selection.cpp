@@ -9,11 +9,21 @@
 
 #include <hpc/ir/builders.h>
 #include <hpc/ast/stmt/ifelse.h>
+#include <hpc/ast/stmt/switchselect.h>
 
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Value.h>
 
 using namespace hpc;
 
+/*!
+ \brief The weights given to the expected and to the unexpected successors of a branch with a \c likely or \c unlikely hint.
+ \note The large ratio lets the block placement move the unexpected successor away from the hot path.
+ */
+static const uint32_t ExpectedBranchWeight = 2000, UnexpectedBranchWeight = 1;
+
 void codegen::ModuleBuilder::visitIfStmt(ast::IfStmt *statement) {
     llvm::Function *irfunc = builder->GetInsertBlock()->getParent();
     
@@ -25,9 +35,20 @@ void codegen::ModuleBuilder::visitIfStmt(ast::IfStmt *statement) {
         falseBlock = llvm::BasicBlock::Create(builder->getContext());
     
     
-    builder->CreateCondBr(build(statement->getCondition()), trueBlock, statement->hasElseBlock() ? falseBlock : remergeBlock);
+    llvm::BranchInst *branch = builder->CreateCondBr(build(statement->getCondition()), trueBlock, statement->hasElseBlock() ? falseBlock : remergeBlock);
+    
+    if (statement->getBranchHint() != ast::IfStmt::NoHint) {
+        llvm::MDBuilder mdBuilder(builder->getContext());
+        bool likely = statement->getBranchHint() == ast::IfStmt::Likely;
+        
+        branch->setMetadata(llvm::LLVMContext::MD_prof, likely ? mdBuilder.createBranchWeights(ExpectedBranchWeight, UnexpectedBranchWeight)
+                                                               : mdBuilder.createBranchWeights(UnexpectedBranchWeight, ExpectedBranchWeight));
+    }
     irfunc->getBasicBlockList().push_back(trueBlock);
     
+    sealBlock(trueBlock);
+    if (falseBlock) sealBlock(falseBlock);
+    
     if (ast::Stmt *thenBlock = statement->getThenBlock()) {
         builder->SetInsertPoint(trueBlock);
         build(thenBlock);
@@ -43,5 +64,63 @@ void codegen::ModuleBuilder::visitIfStmt(ast::IfStmt *statement) {
     }
     
     irfunc->getBasicBlockList().push_back(remergeBlock);
+    sealBlock(remergeBlock);
+    builder->SetInsertPoint(remergeBlock);
+}
+
+void codegen::ModuleBuilder::visitSwitchStmt(ast::SwitchStmt *statement) {
+    llvm::Function *irfunc = builder->GetInsertBlock()->getParent();
+    
+    llvm::Value *selectionVal = build(statement->getSelectionValue());
+    llvm::BasicBlock *remergeBlock = llvm::BasicBlock::Create(builder->getContext());
+    
+    table.setBreakBlock(*statement, remergeBlock);
+    
+    // the variables of the block live in all of its labels, so their lifetime starts before the selection.
+    ast::CompoundStmt *block = statement->getBlock();
+    beginScope(block);
+    
+    // the values are added by the labels, so that LLVM can lower the dense ones to a jump table.
+    llvm::SwitchInst *switchInst = builder->CreateSwitch(selectionVal, remergeBlock);
+    table.setValForComponent(statement, switchInst);
+    
+    // the statements before the first label are never executed.
+    llvm::BasicBlock *unreachableBlock = llvm::BasicBlock::Create(builder->getContext());
+    irfunc->getBasicBlockList().push_back(unreachableBlock);
+    sealBlock(unreachableBlock);
+    builder->SetInsertPoint(unreachableBlock);
+    
+    for (ast::Stmt *substmt : block->statements())
+        takeStmt(substmt);
+    
+    endScope();
+    builder->CreateTerminatorIfNeeded(remergeBlock);
+    
+    irfunc->getBasicBlockList().push_back(remergeBlock);
+    sealBlock(remergeBlock);
     builder->SetInsertPoint(remergeBlock);
 }
+
+void codegen::ModuleBuilder::visitCaseStmt(ast::CaseStmt *statement) {
+    llvm::Function *irfunc = builder->GetInsertBlock()->getParent();
+    llvm::SwitchInst *switchInst = llvm::cast<llvm::SwitchInst>(table.getValForComponent(statement->getSwitch()));
+    
+    // the statements before the label fall through it.
+    llvm::BasicBlock *caseBlock = llvm::BasicBlock::Create(builder->getContext());
+    builder->CreateTerminatorIfNeeded(caseBlock);
+    irfunc->getBasicBlockList().push_back(caseBlock);
+    builder->SetInsertPoint(caseBlock);
+    
+    if (statement->isDefault()) {
+        switchInst->setDefaultDest(caseBlock);
+    } else {
+        for (ast::Expr *value : statement->getValues()) {
+            // the values have been cast to the selection type by the validator, so they are folded into constants.
+            llvm::ConstantInt *caseValue = llvm::cast<llvm::ConstantInt>(build(value));
+            switchInst->addCase(caseValue, caseBlock);
+        }
+    }
+    
+    // the label is reached from the switch and from the statements before it.
+    sealBlock(caseBlock);
+}
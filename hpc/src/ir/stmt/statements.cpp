@@ -11,46 +11,172 @@
 #include <hpc/ast/decls/variable.h>
 #include <hpc/ast/decls/function.h>
 #include <hpc/ast/stmt/statement.h>
+#include <hpc/ast/stmt/whileuntil.h>
+#include <hpc/ast/stmt/switchselect.h>
+#include <hpc/ast/exprs/reference.h>
 
+#include <llvm/IR/Constants.h>
 #include <llvm/IR/Value.h>
 
+#include <algorithm>
+
 using namespace hpc;
 
+void codegen::ModuleBuilder::createLifetimeMarker(ast::Var *var, bool start) {
+    if (isSSAVar(var)) return; // the variable has no stack slot.
+    
+    llvm::Value *slot = table.getValForComponent(var);
+    llvm::ConstantInt *size = builder->getInt64(getDataLayout().getTypeAllocSize(getIRType(var->getType())));
+    
+    if (start) builder->CreateLifetimeStart(slot, size);
+    else builder->CreateLifetimeEnd(slot, size);
+}
+
+void codegen::ModuleBuilder::endScopes(size_t depth) {
+    for (size_t i = scopes.size(); i > depth; i--) {
+        for (ast::Var *var : scopes[i - 1].second) createLifetimeMarker(var, false);
+    }
+}
+
+size_t codegen::ModuleBuilder::getLoopScopeDepth(ast::Stmt *loop) const {
+    ast::Stmt *body = nullptr;
+    if (ast::SimpleIterStmt *iteration = llvm::dyn_cast<ast::SimpleIterStmt>(loop)) body = iteration->getBlock();
+    else if (ast::SwitchStmt *switchStmt = llvm::dyn_cast<ast::SwitchStmt>(loop)) body = switchStmt->getBlock();
+    
+    for (size_t i = scopes.size(); i > 0; i--) {
+        if (body && scopes[i - 1].first == body) return i - 1;
+    }
+    return scopes.size(); // the body is not a block, so it declares no variable.
+}
+
+void codegen::ModuleBuilder::beginScope(ast::CompoundStmt *block) {
+    std::vector<ast::Var *> declared;
+    for (ast::Stmt *substmt : block->statements()) {
+        if (ast::VarDeclStmt *declaration = llvm::dyn_cast<ast::VarDeclStmt>(substmt)) {
+            declared.insert(declared.end(), declaration->getDeclaredVariables().begin(), declaration->getDeclaredVariables().end());
+        }
+    }
+    
+    // a block inside a loop starts the lifetime of its variables on every iteration.
+    for (ast::Var *var : declared) createLifetimeMarker(var, true);
+    scopes.push_back({ block, declared });
+}
+
+void codegen::ModuleBuilder::endScope() {
+    // the lifetime has already ended if the block is left by a return, break or continue statement.
+    if (!builder->GetInsertBlock()->getTerminator()) endScopes(scopes.size() - 1);
+    scopes.pop_back();
+}
+
 void codegen::ModuleBuilder::visitCompoundStmt(ast::CompoundStmt *statement) {
+    beginScope(statement);
+    
     for (ast::Stmt *substmt : statement->statements())
         takeStmt(substmt);
+    
+    endScope();
 }
 
 void codegen::ModuleBuilder::visitVarDeclStmt(ast::VarDeclStmt *statement) {
     for (ast::Var *variable : statement->getDeclaredVariables()) {
         // TODO stack objects initializations
         
-        if (ast::Expr *initVal = variable->getInitialValue()) assign(variable, build(initVal));
+        ast::Expr *initVal = variable->getInitialValue();
+        if (!initVal) continue;
+        
+        // a new object is constructed in place, since nothing can read the variable before its declaration.
+        if (isObjectType(variable->getType())) {
+            createObjectCopy(initVal, table.getOrCreateReference(variable), getAlignment(variable->getType()), true);
+        } else {
+            assign(variable, build(initVal));
+        }
     }
 }
 
 void codegen::ModuleBuilder::visitReturnStmt(ast::ReturnStmt *statement) {
     ast::FunctionDecl *receiver = statement->getReceiver();
     
+    // a call whose value is returned as is can reuse the stack frame, unless the callee may access it through a slice.
+    // Both functions must return the value the same way, so that the callee stores an object returned in memory to the return slot of the receiver.
+    ast::FunctionCall *functionCall = llvm::dyn_cast_or_null<ast::FunctionCall>(statement->getReturnValue());
+    if (functionCall && !receiver->slicesStack()) {
+        ast::FunctionDecl *callee = functionCall->getFunctionDecl();
+        build(callee);
+        llvm::Function *irPrototype = static_cast<llvm::Function *>(table.getValForComponent(callee));
+        llvm::Function *irReceiver = builder->GetInsertBlock()->getParent();
+        
+        const target::FunctionABIInfo &calleeABI = getFunctionABI(callee);
+        bool hasReturnSlot = getFunctionABI(receiver).returnInfo.kind == target::ABIArgInfo::Indirect;
+        
+        if (irPrototype->getReturnType() == irReceiver->getReturnType() && hasReturnSlot == (calleeABI.returnInfo.kind == target::ABIArgInfo::Indirect)) {
+            // a guaranteed tail call must be followed by the return, so the lifetime of the variables ends before it.
+            // The objects it passes in memory are then copied to temporaries, since the variables they come from are dead during the call.
+            bool mustTail = statement->isTailCallRequired();
+            std::vector<llvm::Value *> builtArgs = buildCallArgs(functionCall, hasReturnSlot ? &*irReceiver->arg_begin() : nullptr, mustTail);
+            
+            if (mustTail) endScopes(0);
+            llvm::CallInst *call = builder->CreateCall(irPrototype, builtArgs);
+            call->setAttributes(irPrototype->getAttributes());
+            if (!mustTail) endScopes(0);
+            
+            // the copies of the objects passed in memory are in the stack frame of the receiver.
+            bool hasIndirectArgs = std::any_of(calleeABI.argInfos.begin(), calleeABI.argInfos.end(), [](const target::ABIArgInfo &argInfo) {
+                return argInfo.kind == target::ABIArgInfo::Indirect;
+            });
+            
+            if (mustTail) call->setTailCallKind(llvm::CallInst::TCK_MustTail);
+            else if (!hasIndirectArgs) call->setTailCallKind(llvm::CallInst::TCK_Tail);
+            table.setValForComponent(functionCall, call);
+            
+            table.setValForComponent(statement, hasReturnSlot || call->getType()->isVoidTy() ? builder->CreateRetVoid() : builder->CreateRet(call));
+            return;
+        }
+    }
+    
+    ast::Type *returnType = receiver->getReturnType();
     if (receiver->containedReturns() > 1) {
-        if (!receiver->getReturnType()->isVoidType()) {
-            if (llvm::Value *reg = returnRegister) // FIXME a table keeping links between functions and return registers?
-                builder->CreateStore(build(statement->getReturnValue()), reg);
+        if (!returnType->isVoidType()) {
+            if (llvm::Value *reg = returnRegister) { // FIXME a table keeping links between functions and return registers?
+                if (isObjectType(returnType)) createObjectCopy(statement->getReturnValue(), reg, getAlignment(returnType), true);
+                else builder->CreateAlignedStore(build(statement->getReturnValue()), reg, getAlignment(returnType));
+            }
         }
         
+        endScopes(0);
         table.setValForComponent(statement, builder->CreateBr(returnBlock));
         return;
     }
     
-    if (!receiver->getReturnType()->isVoidType())
-        table.setValForComponent(statement, builder->CreateRet(build(statement->getReturnValue())));
-    else table.setValForComponent(statement, builder->CreateRetVoid());
+    if (!returnType->isVoidType()) {
+        ast::Expr *returnValue = statement->getReturnValue();
+        const target::ABIArgInfo &returnInfo = getFunctionABI(receiver).returnInfo;
+        
+        // the returned object is copied or constructed in the return slot before the variables it may come from end their lifetime.
+        llvm::Value *value = nullptr;
+        if (returnInfo.kind == target::ABIArgInfo::Indirect) {
+            createObjectCopy(returnValue, &*builder->GetInsertBlock()->getParent()->arg_begin(), getAlignment(returnType), true);
+        } else if (returnInfo.kind == target::ABIArgInfo::Coerced) {
+            llvm::Value *reference = table.getOrCreateReference(returnValue);
+            if (reference) value = createCoercedLoad(reference, returnType, getAccessAlignment(returnValue), returnInfo.coercedType);
+            else value = createCoercion(build(returnValue), returnInfo.coercedType);
+        } else {
+            value = build(returnValue);
+        }
+        
+        endScopes(0);
+        table.setValForComponent(statement, value ? builder->CreateRet(value) : builder->CreateRetVoid());
+    } else {
+        endScopes(0);
+        table.setValForComponent(statement, builder->CreateRetVoid());
+    }
 }
 
 void codegen::ModuleBuilder::visitBreakStmt(ast::BreakStmt *statement) {
+    endScopes(getLoopScopeDepth(statement->getBreakCatcher()));
     table.makeBreak(statement->getBreakCatcher());
 }
 
 void codegen::ModuleBuilder::visitContinueStmt(ast::ContinueStmt *statement) {
+    endScopes(getLoopScopeDepth(statement->getContinueCatcher()));
     table.makeContinue(statement->getContinueCatcher());
 }
@@ -0,0 +1,206 @@
+// => src/ir/tbaa.cpp
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#include <hpc/ir/builders.h>
+#include <hpc/ast/decls/class.h>
+#include <hpc/ast/decls/function.h>
+#include <hpc/ast/types/builtintype.h>
+#include <hpc/ast/types/compoundtype.h>
+#include <hpc/ast/exprs/members.h>
+#include <hpc/ast/exprs/reference.h>
+
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Instruction.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/MDBuilder.h>
+
+using namespace hpc;
+
+/*!
+ \brief Returns the built-in type whose TBAA node is used for \c type, so that types with the same representation and different signedness may alias.
+ */
+static ast::BuiltinType::TypeID getAliasingTypeID(ast::BuiltinType *type) {
+    switch (type->getBuiltinTypeID()) {
+        case ast::BuiltinType::UTF16Character:
+        case ast::BuiltinType::UnsignedShort:
+            return ast::BuiltinType::SignedShort;
+        case ast::BuiltinType::UTF32Character:
+        case ast::BuiltinType::UnsignedInteger:
+            return ast::BuiltinType::SignedInteger;
+        case ast::BuiltinType::UnsignedLong:
+            return ast::BuiltinType::SignedLong;
+        case ast::BuiltinType::UnsignedLongLong:
+            return ast::BuiltinType::SignedLongLong;
+
+        default:
+            return type->getBuiltinTypeID();
+    }
+}
+
+llvm::MDNode *codegen::ModuleBuilder::getTBAATypeNode(ast::Type *type) {
+    type = type->getCanonicalType();
+
+    // constant objects have the same representation as the others.
+    if (ast::QualifiedType *qualType = llvm::dyn_cast<ast::QualifiedType>(type)) type = qualType->getEnclosingType()->getCanonicalType();
+
+    llvm::MDBuilder mdBuilder(getModule().getContext());
+
+    if (!tbaaRoot) {
+        tbaaRoot = mdBuilder.createTBAARoot("Human Plus TBAA");
+        tbaaCharNode = mdBuilder.createTBAAScalarTypeNode("omnipotent char", tbaaRoot);
+    }
+
+    if (ast::BuiltinType *builtinType = llvm::dyn_cast<ast::BuiltinType>(type)) {
+        switch (getAliasingTypeID(builtinType)) {
+            case ast::BuiltinType::Character:
+            case ast::BuiltinType::SignedByte:
+            case ast::BuiltinType::UnsignedByte:
+                return tbaaCharNode; // bytes may be used to access the representation of any object.
+
+            case ast::BuiltinType::String: // strings are pointers to characters.
+                return getTBAATypeNode(builtinType->pointerTo());
+
+            default:
+                type = ast::BuiltinType::get(getAliasingTypeID(builtinType));
+                break;
+        }
+    } else if (type->isPointerType()) {
+        // pointers are often converted between pointed types, so they all share a single node.
+        type = ast::BuiltinType::get(ast::BuiltinType::Void)->pointerTo();
+    } else if (type->isVectorType()) {
+        return tbaaCharNode; // lanes of vectors may be accessed as scalars through pointers.
+    } else if (type->isArrayType() || type->isSliceType()) {
+        return nullptr;
+    }
+
+    llvm::MDNode *&node = tbaaTypeNodes[type];
+    if (node) return node;
+
+    if (ast::ClassType *classType = llvm::dyn_cast<ast::ClassType>(type)) {
+        llvm::StructType *structType = llvm::cast<llvm::StructType>(getIRType(classType));
+        const llvm::StructLayout *structLayout = getDataLayout().getStructLayout(structType);
+
+        // the fields are listed in the order they are laid out, so that their offsets are increasing.
+        std::vector<std::pair<llvm::MDNode *, uint64_t>> fields;
+        for (ast::FieldDecl *field : getFieldsLayout(classType->getDeclarator())) {
+            if (llvm::MDNode *fieldNode = getTBAATypeNode(field->getType())) {
+                fields.push_back(std::make_pair(fieldNode, structLayout->getElementOffset(table.getFieldSlot(field))));
+            }
+        }
+
+        return node = mdBuilder.createTBAAStructTypeNode(structType->getName(), fields);
+    }
+
+    ast::BuiltinType *builtinType = llvm::dyn_cast<ast::BuiltinType>(type);
+    return node = mdBuilder.createTBAAScalarTypeNode(builtinType ? builtinType->getIdentifier() : "any pointer", tbaaCharNode);
+}
+
+llvm::MDNode *codegen::ModuleBuilder::getTBAAAccessTag(ast::Expr *reference) {
+    ast::Type *accessType = reference->evalType()->getCanonicalType();
+    if (llvm::isa<ast::ClassType>(accessType)) return nullptr; // copies of whole objects may be split or merged by LLVM.
+
+    llvm::MDNode *accessNode = getTBAATypeNode(accessType);
+    if (!accessNode) return nullptr;
+
+    // the tag describes the access as a field at some offset of the outermost class object being accessed.
+    ast::Type *baseType = accessType;
+    uint64_t offset = 0;
+
+    ast::Expr *entity = reference;
+    while (ast::FieldRef *fieldRef = llvm::dyn_cast<ast::FieldRef>(entity)) {
+        // each column of an array stored by columns holds scalars, not objects.
+        ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(fieldRef->getEntity());
+        if (subscript && subscript->isColumnAccess()) break;
+
+        ast::ClassType *classType = fieldRef->getDeclaration()->getEnclosingType();
+        llvm::StructType *structType = llvm::cast<llvm::StructType>(getIRType(classType));
+        offset += getDataLayout().getStructLayout(structType)->getElementOffset(table.getFieldSlot(fieldRef->getDeclaration()));
+
+        baseType = classType;
+        entity = fieldRef->getEntity();
+    }
+
+    llvm::MDBuilder mdBuilder(getModule().getContext());
+    return mdBuilder.createTBAAStructTagNode(getTBAATypeNode(baseType), accessNode, offset);
+}
+
+void codegen::ModuleBuilder::addAccessTag(llvm::Instruction *access, ast::Expr *reference) {
+    addAliasScopes(access, reference);
+
+    if (!strictAliasing) return;
+
+    if (llvm::MDNode *tag = getTBAAAccessTag(reference)) {
+        access->setMetadata(llvm::LLVMContext::MD_tbaa, tag);
+    }
+}
+
+void codegen::ModuleBuilder::addAccessTag(llvm::Instruction *access, ast::Type *type) {
+    if (!strictAliasing) return;
+
+    type = type->getCanonicalType();
+    if (llvm::isa<ast::ClassType>(type)) return;
+
+    if (llvm::MDNode *typeNode = getTBAATypeNode(type)) {
+        llvm::MDBuilder mdBuilder(getModule().getContext());
+        access->setMetadata(llvm::LLVMContext::MD_tbaa, mdBuilder.createTBAAStructTagNode(typeNode, typeNode, 0));
+    }
+}
+
+void codegen::ModuleBuilder::createAliasScopes(ast::FunctionDecl *function) {
+    aliasScopes.clear();
+
+    std::vector<ast::Var *> exclusiveVars;
+    for (ast::ParamVar *arg : function->getArgs()) {
+        if (arg->getType()->isExclusive() && arg->getType()->isSliceType()) exclusiveVars.push_back(arg);
+    }
+    for (ast::Var *localVar : function->getLocalVars()) {
+        if (localVar->getType()->isExclusive() && localVar->getType()->isSliceType()) exclusiveVars.push_back(localVar);
+    }
+
+    // a single exclusive slice has no other exclusive slice to be distinguished from.
+    if (exclusiveVars.size() < 2) return;
+
+    llvm::MDBuilder mdBuilder(getModule().getContext());
+    llvm::MDNode *domain = mdBuilder.createAliasScopeDomain(function->getName());
+
+    for (ast::Var *var : exclusiveVars) {
+        aliasScopes[var] = mdBuilder.createAliasScope(var->getName(), domain);
+    }
+}
+
+void codegen::ModuleBuilder::addAliasScopes(llvm::Instruction *access, ast::Expr *reference) {
+    if (aliasScopes.empty()) return;
+
+    // finds the slice containing the accessed memory, if any.
+    ast::Expr *entity = reference;
+    while (true) {
+        if (ast::FieldRef *fieldRef = llvm::dyn_cast<ast::FieldRef>(entity)) {
+            entity = fieldRef->getEntity();
+        } else if (ast::SubscriptExpr *subscript = llvm::dyn_cast<ast::SubscriptExpr>(entity)) {
+            entity = subscript->getEntity();
+            if (entity->evalType()->isSliceType()) break;
+        } else return;
+    }
+
+    ast::VarRef *varRef = llvm::dyn_cast<ast::VarRef>(entity);
+    if (!varRef) return;
+
+    auto scope = aliasScopes.find(varRef->getVar());
+    if (scope == aliasScopes.end()) return;
+
+    std::vector<llvm::Metadata *> otherScopes;
+    for (auto &otherScope : aliasScopes) {
+        if (otherScope.first != scope->first) otherScopes.push_back(otherScope.second);
+    }
+
+    llvm::LLVMContext &context = getModule().getContext();
+    access->setMetadata(llvm::LLVMContext::MD_alias_scope, llvm::MDNode::get(context, scope->second));
+    access->setMetadata(llvm::LLVMContext::MD_noalias, llvm::MDNode::get(context, otherScopes));
+}
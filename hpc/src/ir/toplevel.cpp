@@ -16,53 +16,79 @@
 #include <hpc/ast/decls/function.h>
 
 #include <llvm/IR/Value.h>
+#include <llvm/Transforms/Utils/ModuleUtils.h>
 
 using namespace hpc;
 
 void codegen::ModuleBuilder::visitNameSpaceDecl(ast::NameSpaceDecl *nameSpace) {
     
     for (ast::Decl *decl : nameSpace->getDeclarations())
-        takeDecl(decl);
+        if (shouldBuild(decl)) takeDecl(decl);
     
 }
 
 void codegen::ModuleBuilder::visitGlobalVar(ast::GlobalVar *var) {
     llvm::Module &module = getModule();
+    llvm::Type *irType = getIRType(var->getType());
     
-    llvm::Value *initializer = nullptr;
-    llvm::BasicBlock *ginitblock = nullptr;
+    llvm::GlobalVariable *GV = new llvm::GlobalVariable(module, irType, false, llvm::GlobalValue::ExternalLinkage,
+                                                        llvm::Constant::getNullValue(irType), getTargetInfo().getMangle().mangleGlobalVariable(var));
+    GV->setAlignment(getAlignment(var->getType()));
+    table.setValForComponent(var, GV);
     
-    llvm::Constant *constinit = nullptr;
-    if (var->getInitialValue()) {
-        builder = new InstructionBuilder(module.getContext());
-        ginitblock = llvm::BasicBlock::Create(module.getContext());
-        builder->SetInsertPoint(ginitblock);
-        
-        
-        initializer = build(var->getInitialValue());
-        
-        constinit = llvm::dyn_cast<llvm::Constant>(initializer);
+    if (!var->getInitialValue()) return;
+    
+    if (!globalInitFunction) {
+        globalInitFunction = llvm::Function::Create(llvm::FunctionType::get(llvm::Type::getVoidTy(module.getContext()), false),
+                                                    llvm::GlobalValue::InternalLinkage, "__hplus_global_var_init", &module);
+        globalInitFunction->setSection("__TEXT,__StaticInit,regular,pure_instructions");
+        globalInitFunction->addFnAttr(llvm::Attribute::NoUnwind);
+        globalInitFunction->addFnAttr(llvm::Attribute::StackProtect);
+        globalInitFunction->addFnAttr(llvm::Attribute::UWTable);
+        globalInitBlock = llvm::BasicBlock::Create(module.getContext(), "", globalInitFunction);
     }
     
-    bool isConstantInit = constinit;
-    if (!constinit) {
-        constinit = llvm::Constant::getNullValue(getIRType(var->getType()));
+    // the initial value is built in the initialization function, where it only leaves instructions if it is not known at compile time.
+    builder = new InstructionBuilder(module.getContext());
+    builder->SetInsertPoint(globalInitBlock);
+    trapBlock = nullptr;
+    table.pushFunction();
+    
+    llvm::Value *initializer = build(var->getInitialValue());
+    if (var->getType()->isBooleanType()) {
+        initializer = builder->CreateZExt(initializer, irType);
     }
     
-    llvm::GlobalVariable *GV = new llvm::GlobalVariable(module, getIRType(var->getType()), /*var.getType()->isConstant()*/false,
-                                                        llvm::GlobalValue::ExternalLinkage, constinit, getTargetInfo().getMangle().mangleGlobalVariable(var));
-    //GV->setAlignment(type->getAlignment());
-    table.setValForComponent(var, GV);
+    // the performance lint warns about the initial values that are not constant by the same rule, so the others must be folded here.
+    llvm::Constant *constant = var->hasConstantInitializer() ? llvm::dyn_cast<llvm::Constant>(initializer) : nullptr;
+    assert((constant || !var->hasConstantInitializer()) && "Constant initial value not folded.");
     
-    if (var->getInitialValue() && !isConstantInit) {
-        llvm::Function *globalinit = llvm::Function::Create(llvm::FunctionType::get(llvm::Type::getVoidTy(builder->getContext()), false),
-                                                            llvm::GlobalValue::InternalLinkage, "__hplus_global_var_init", &module);
-        globalinit->setSection("__TEXT,__StaticInit,regular,pure_instructions");
-        globalinit->addFnAttr(llvm::Attribute::StackProtect);
-        globalinit->addFnAttr(llvm::Attribute::UWTable);
-        assign(var, initializer);
-        builder->CreateRetVoid();
-        globalinit->getBasicBlockList().push_back(ginitblock);
+    if (constant) {
+        GV->setInitializer(constant);
+        
+        // a constant variable is never written after its static initialization, so its loads can be folded.
+        GV->setConstant(var->getType()->isConstant());
+    } else {
+        llvm::StoreInst *store = builder->CreateAlignedStore(initializer, GV, getAlignment(var->getType()));
+        addAccessTag(store, var->getType());
     }
+    
+    globalInitBlock = builder->GetInsertBlock();
+    table.popFunction();
+    delete builder;
     builder = nullptr;
 }
+
+void codegen::ModuleBuilder::finalizeGlobalInit() {
+    if (!globalInitFunction) return;
+    
+    // no initial value needed to be computed at program startup.
+    if (&globalInitFunction->getEntryBlock() == globalInitBlock && globalInitBlock->empty()) {
+        globalInitFunction->eraseFromParent();
+        globalInitFunction = nullptr;
+        return;
+    }
+    
+    llvm::ReturnInst::Create(getModule().getContext(), globalInitBlock);
+    llvm::appendToGlobalCtors(getModule(), globalInitFunction, 65535);
+}
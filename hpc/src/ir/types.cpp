@@ -12,9 +12,16 @@
 #include <hpc/ast/types/builtintype.h>
 #include <hpc/ast/types/pointertype.h>
 #include <hpc/ast/types/compoundtype.h>
+#include <hpc/ast/types/vectortype.h>
+#include <hpc/ast/types/arraytype.h>
 
 #include <llvm/ADT/ArrayRef.h>
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/Type.h>
+#include <llvm/Support/MathExtras.h>
+
+#include <algorithm>
 
 using namespace hpc;
 
@@ -70,16 +77,83 @@ void codegen::ModuleBuilder::visitPointerType(ast::PointerType *type) {
     table.setIRType(type, llvm::PointerType::get(getIRType(type->getPointedType()), 0));
 }
 
-void codegen::ModuleBuilder::visitClassType(ast::ClassType *type) {
+std::vector<llvm::Type *> codegen::ModuleBuilder::getClassElementTypes(ast::ClassDecl *classDecl, const std::vector<ast::FieldDecl *> &fields, std::vector<unsigned> &slots) {
+    llvm::DataLayout &dataLayout = getDataLayout();
+    llvm::LLVMContext &context = getModule().getContext();
+    bool packed = classDecl->isPacked();
     
     std::vector<llvm::Type *> fieldTypes;
+    uint64_t offset = 0;
+    
+    for (ast::FieldDecl *field : fields) {
+        llvm::Type *fieldType = getIRType(field->getType());
+        
+        if (!packed) {
+            uint64_t end = offset;
+            uint64_t naturalOffset = llvm::alignTo(end, dataLayout.getABITypeAlignment(fieldType));
+            offset = llvm::alignTo(naturalOffset, std::max(getRequestedAlignment(field->getType()), 1u));
+            
+            // fields of classes aligned beyond their structure alignment are moved to their offset by explicit padding.
+            if (offset > naturalOffset) {
+                fieldTypes.push_back(llvm::ArrayType::get(llvm::Type::getInt8Ty(context), offset - end));
+            }
+        }
+        
+        slots.push_back(fieldTypes.size());
+        fieldTypes.push_back(fieldType);
+        offset += dataLayout.getTypeAllocSize(fieldType);
+    }
     
-    for (ast::FieldDecl *field : type->getFields()) {
-        fieldTypes.push_back(getIRType(field->getType()));
+    // the size must be a multiple of the alignment, so that every element of an array is aligned too.
+    uint64_t sizeMultiple = std::max(getTargetInfo().getClassAlignment(classDecl), getClassPadding(classDecl));
+    if (sizeMultiple > 1) {
+        uint64_t size = dataLayout.getTypeAllocSize(llvm::StructType::get(context, fieldTypes, packed));
+        
+        if (size % sizeMultiple) {
+            fieldTypes.push_back(llvm::ArrayType::get(llvm::Type::getInt8Ty(context), sizeMultiple - size % sizeMultiple));
+        }
     }
     
-    table.setIRType(type, llvm::StructType::create(llvm::makeArrayRef(fieldTypes.data(), fieldTypes.size()),
-                                                   getTargetInfo().getMangle().mangleClass(type->getDeclarator())));
+    return fieldTypes;
+}
+
+void codegen::ModuleBuilder::visitClassType(ast::ClassType *type) {
+    ast::ClassDecl *classDecl = type->getDeclarator();
+    
+    std::vector<ast::FieldDecl *> fields = getFieldsLayout(classDecl);
+    std::vector<unsigned> slots;
+    std::vector<llvm::Type *> fieldTypes = getClassElementTypes(classDecl, fields, slots);
+    
+    for (unsigned i = 0; i < fields.size(); i++) table.setFieldSlot(fields[i], slots[i]);
+    
+    table.setIRType(type, llvm::StructType::create(getModule().getContext(), fieldTypes, getTargetInfo().getMangle().mangleClass(classDecl), classDecl->isPacked()));
+}
+
+void codegen::ModuleBuilder::visitVectorType(ast::VectorType *type) {
+    table.setIRType(type, llvm::VectorType::get(getIRType(type->getElementType()), type->getNumLanes()));
+}
+
+void codegen::ModuleBuilder::visitArrayType(ast::ArrayType *type) {
+    if (type->isStoredByColumns()) {
+        // { [N x field1], [N x field2], ... }, in declaration order.
+        ast::ClassDecl *classDecl = llvm::cast<ast::ClassType>(type->getElementType()->getCanonicalType())->getDeclarator();
+        
+        std::vector<llvm::Type *> columnTypes;
+        for (ast::FieldDecl *field : classDecl->getFields()) {
+            columnTypes.push_back(llvm::ArrayType::get(getIRType(field->getType()), type->getLength()));
+        }
+        
+        table.setIRType(type, llvm::StructType::get(getModule().getContext(), columnTypes));
+        return;
+    }
+    
+    table.setIRType(type, llvm::ArrayType::get(getIRType(type->getElementType()), type->getLength()));
+}
+
+void codegen::ModuleBuilder::visitSliceType(ast::SliceType *type) {
+    // { data, length }
+    llvm::LLVMContext &context = getModule().getContext();
+    table.setIRType(type, llvm::StructType::get(context, { getIRType(type->getElementType())->getPointerTo(), llvm::Type::getInt64Ty(context) }));
 }
 
 void codegen::ModuleBuilder::visitQualifiedType(ast::QualifiedType *type) {
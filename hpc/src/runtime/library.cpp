@@ -0,0 +1,196 @@
+// => src/runtime/library.cpp
+//
+//                     The Human Plus Project
+//
+// This file is distributed under the University of Illinois/NCSA
+// Open Source License. See LICENSE.TXT for details.
+//
+//
+
+#include <hpc/runtime/library.h>
+
+#include <llvm/Analysis/ValueTracking.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+
+#include <string>
+
+using namespace hpc;
+
+static const runtime::RuntimeFunctionInfo runtimeFunctions[runtime::NumRuntimeFunctions] = {
+    { "readChar",       0, -1 },
+    { "readInteger",    0, -1 },
+    { "writeChar",      1, -1 },
+    { "writeInteger",   1, -1 },
+    { "writeString",    1,  0 },
+};
+
+const runtime::RuntimeFunctionInfo &runtime::getRuntimeFunctionInfo(RuntimeFunction runtimeFunction) {
+    return runtimeFunctions[runtimeFunction];
+}
+
+bool runtime::getRuntimeFunction(const llvm::Function &function, RuntimeFunction &runtimeFunction) {
+    if (!function.isDeclaration() || !function.getReturnType()->isIntegerTy()) return false;
+    
+    for (unsigned i = 0; i < NumRuntimeFunctions; i++) {
+        const RuntimeFunctionInfo &info = runtimeFunctions[i];
+        if (function.getName() != info.name) continue;
+        
+        // a function declared with another prototype is not the one of the runtime.
+        if (function.arg_size() != info.numArgs) return false;
+        for (const llvm::Argument &arg : function.args()) {
+            bool isString = (int)arg.getArgNo() == info.stringArg;
+            if (isString ? !arg.getType()->isPointerTy() : !arg.getType()->isIntegerTy()) return false;
+        }
+        
+        runtimeFunction = (RuntimeFunction)i;
+        return true;
+    }
+    
+    return false;
+}
+
+bool runtime::addRuntimeAttributes(llvm::Function &function) {
+    RuntimeFunction runtimeFunction;
+    if (!getRuntimeFunction(function, runtimeFunction)) return false;
+    
+    const RuntimeFunctionInfo &info = getRuntimeFunctionInfo(runtimeFunction);
+    function.addFnAttr(llvm::Attribute::NoUnwind);
+    
+    if (info.stringArg < 0) {
+        function.addFnAttr(llvm::Attribute::InaccessibleMemOnly);
+        return true;
+    }
+    
+    function.addFnAttr(llvm::Attribute::InaccessibleMemOrArgMemOnly);
+    function.addAttribute(info.stringArg + 1, llvm::Attribute::NoCapture);
+    function.addAttribute(info.stringArg + 1, llvm::Attribute::ReadOnly);
+    return true;
+}
+
+
+namespace {
+    
+    /*!
+     \brief Pass which simplifies the calls to the runtime functions whose arguments are known.
+     */
+    class RuntimeCallsPass : public llvm::FunctionPass {
+        
+        /*!
+         \brief Returns whether \c call calls the given runtime function, and its result is not used.
+         */
+        static bool isUnusedCall(llvm::CallInst *call, runtime::RuntimeFunction expected) {
+            llvm::Function *callee = call->getCalledFunction();
+            runtime::RuntimeFunction runtimeFunction;
+            
+            return callee && call->use_empty() && runtime::getRuntimeFunction(*callee, runtimeFunction) && runtimeFunction == expected;
+        }
+        
+        /*!
+         \brief Returns the declaration of \c writeChar in the given module, creating it if needed, or \c nullptr if the module declares it with another prototype.
+         */
+        static llvm::Function *getWriteChar(llvm::Module &module) {
+            const char *name = runtime::getRuntimeFunctionInfo(runtime::WriteChar).name;
+            runtime::RuntimeFunction runtimeFunction;
+            
+            if (llvm::Function *function = module.getFunction(name)) {
+                return runtime::getRuntimeFunction(*function, runtimeFunction) ? function : nullptr;
+            }
+            
+            llvm::LLVMContext &context = module.getContext();
+            llvm::FunctionType *type = llvm::FunctionType::get(llvm::Type::getInt32Ty(context), { llvm::Type::getInt8Ty(context) }, false);
+            llvm::Function *function = llvm::Function::Create(type, llvm::GlobalValue::ExternalLinkage, name, &module);
+            
+            // characters are promoted to int by the C callers of the runtime.
+            function->addAttribute(1, llvm::Attribute::SExt);
+            runtime::addRuntimeAttributes(*function);
+            return function;
+        }
+        
+        /*!
+         \brief Writes the single character written by \c call with \c writeChar instead of \c writeString, which saves the search of the end of the string.
+         */
+        static bool simplifyWrite(llvm::CallInst *call, llvm::StringRef string) {
+            if (string.size() != 1) return false;
+            
+            llvm::Function *writeChar = getWriteChar(*call->getModule());
+            if (!writeChar) return false;
+            
+            llvm::Type *charType = writeChar->getFunctionType()->getParamType(0);
+            llvm::CallInst *charCall = llvm::CallInst::Create(writeChar, { llvm::ConstantInt::get(charType, string[0]) }, "", call);
+            charCall->setAttributes(writeChar->getAttributes());
+            charCall->setDebugLoc(call->getDebugLoc());
+            
+            call->eraseFromParent();
+            return true;
+        }
+        
+    public:
+        static char ID;
+        
+        RuntimeCallsPass() : llvm::FunctionPass(ID) {  }
+        
+        llvm::StringRef getPassName() const override {
+            return "Human Plus runtime calls simplification";
+        }
+        
+        void getAnalysisUsage(llvm::AnalysisUsage &usage) const override {
+            usage.setPreservesCFG();
+        }
+        
+        bool runOnFunction(llvm::Function &function) override {
+            bool changed = false;
+            
+            for (llvm::BasicBlock &block : function) {
+                // the last call writing a constant string, which also writes the strings of the calls following it.
+                llvm::CallInst *pending = nullptr;
+                std::string pendingString;
+                
+                for (auto it = block.begin(); it != block.end(); ) {
+                    llvm::Instruction *instruction = &*it++;
+                    
+                    llvm::CallInst *call = llvm::dyn_cast<llvm::CallInst>(instruction);
+                    llvm::StringRef string;
+                    if (call && isUnusedCall(call, runtime::WriteString) && llvm::getConstantStringInfo(call->getArgOperand(0), string)) {
+                        if (!pending && !string.empty()) {
+                            pending = call;
+                            pendingString = string.str();
+                            continue;
+                        }
+                        
+                        // writing an empty string has no effect.
+                        if (!string.empty()) {
+                            pendingString += string.str();
+                            llvm::IRBuilder<> builder(pending);
+                            pending->setArgOperand(0, builder.CreateGlobalStringPtr(pendingString, ".str"));
+                        }
+                        
+                        call->eraseFromParent();
+                        changed = true;
+                        continue;
+                    }
+                    
+                    // the output of the calls cannot be merged over another access to memory.
+                    if (instruction->mayReadOrWriteMemory() || instruction->mayHaveSideEffects()) {
+                        if (pending) changed |= simplifyWrite(pending, pendingString);
+                        pending = nullptr;
+                    }
+                }
+                
+                if (pending) changed |= simplifyWrite(pending, pendingString);
+            }
+            
+            return changed;
+        }
+        
+    };
+    
+}
+
+char RuntimeCallsPass::ID = 0;
+
+llvm::FunctionPass *runtime::createRuntimeCallsPass() {
+    return new RuntimeCallsPass();
+}
@@ -10,11 +10,18 @@
 #include <hpc/target/abi.h>
 #include <hpc/ast/types/type.h>
 
+#include <llvm/ADT/Triple.h>
+#include <llvm/IR/DerivedTypes.h>
+
+#include <algorithm>
 #include <sstream>
 
 using namespace hpc;
 
 target::TargetABI *target::TargetABI::createABI(opts::TargetOptions &opts) {
+    llvm::Triple triple(opts.targetTriple);
+    if (triple.getArch() == llvm::Triple::x86_64 && !triple.isOSWindows()) return new X8664SysVABI(opts);
+    
     return new TargetABI(opts, CXXGenericARM); // FIXME
 }
 
@@ -76,4 +83,165 @@ bool target::TargetABI::isMicrosoftABI() const {
     llvm_unreachable("Invalid ABI.");
 }
 
+target::FunctionABIInfo target::TargetABI::classifyFunction(llvm::Type *returnType, const std::vector<llvm::Type *> &paramTypes, const llvm::DataLayout &dataLayout) const {
+    FunctionABIInfo info;
+    info.argInfos.resize(paramTypes.size());
+    return info;
+}
+
+
+/*!
+ \brief Returns the scalar or vector starting exactly at \c offset in a value of the given type, or \c nullptr if no such element exists.
+ */
+static llvm::Type *getScalarAtOffset(llvm::Type *type, uint64_t offset, const llvm::DataLayout &dataLayout) {
+    if (llvm::StructType *structType = llvm::dyn_cast<llvm::StructType>(type)) {
+        const llvm::StructLayout *layout = dataLayout.getStructLayout(structType);
+        if (offset >= layout->getSizeInBytes()) return nullptr;
+        
+        unsigned element = layout->getElementContainingOffset(offset);
+        return getScalarAtOffset(structType->getElementType(element), offset - layout->getElementOffset(element), dataLayout);
+    }
+    
+    if (llvm::ArrayType *arrayType = llvm::dyn_cast<llvm::ArrayType>(type)) {
+        uint64_t elementSize = dataLayout.getTypeAllocSize(arrayType->getElementType());
+        if (offset >= elementSize * arrayType->getNumElements()) return nullptr;
+        
+        return getScalarAtOffset(arrayType->getElementType(), offset % elementSize, dataLayout);
+    }
+    
+    return offset == 0 ? type : nullptr;
+}
+
+void target::X8664SysVABI::classifyEightbytes(llvm::Type *type, uint64_t offset, ArgClass classes[2], const llvm::DataLayout &dataLayout) const {
+    if (llvm::StructType *structType = llvm::dyn_cast<llvm::StructType>(type)) {
+        const llvm::StructLayout *layout = dataLayout.getStructLayout(structType);
+        
+        for (unsigned i = 0; i < structType->getNumElements(); i++) {
+            llvm::Type *elementType = structType->getElementType(i);
+            uint64_t elementOffset = offset + layout->getElementOffset(i);
+            
+            // the misaligned fields of packed classes cannot be loaded to registers.
+            if (elementOffset % dataLayout.getABITypeAlignment(elementType)) {
+                classes[0] = classes[1] = Memory;
+                return;
+            }
+            
+            classifyEightbytes(elementType, elementOffset, classes, dataLayout);
+        }
+        return;
+    }
+    
+    if (llvm::ArrayType *arrayType = llvm::dyn_cast<llvm::ArrayType>(type)) {
+        uint64_t elementSize = dataLayout.getTypeAllocSize(arrayType->getElementType());
+        
+        for (uint64_t i = 0; i < arrayType->getNumElements(); i++) {
+            classifyEightbytes(arrayType->getElementType(), offset + i * elementSize, classes, dataLayout);
+        }
+        return;
+    }
+    
+    uint64_t size = dataLayout.getTypeStoreSize(type);
+    
+    // a vector filling both eightbytes is the only element of its aggregate, and is passed in a single register.
+    if (type->isVectorTy() && size == 16) {
+        classes[0] = SSE;
+        classes[1] = SSEUp;
+        return;
+    }
+    
+    ArgClass argClass = Memory;
+    if (type->isIntegerTy() || type->isPointerTy()) argClass = Integer;
+    else if (type->isFloatTy() || type->isDoubleTy() || (type->isVectorTy() && size <= 8)) argClass = SSE;
+    
+    unsigned index = offset / 8;
+    if (index > 1 || (offset + size - 1) / 8 != index) {
+        classes[0] = classes[1] = Memory;
+        return;
+    }
+    
+    // an eightbyte holding both integers and floating point values is passed in an integer register.
+    ArgClass &current = classes[index];
+    if (current == NoClass) current = argClass;
+    else if (current == Memory || argClass == Memory) current = Memory;
+    else if (current == Integer || argClass == Integer) current = Integer;
+    else current = SSE;
+}
 
+llvm::Type *target::X8664SysVABI::getEightbyteType(llvm::Type *type, uint64_t offset, ArgClass argClass, const llvm::DataLayout &dataLayout) const {
+    llvm::LLVMContext &context = type->getContext();
+    uint64_t size = std::min<uint64_t>(8, dataLayout.getTypeAllocSize(type) - offset);
+    llvm::Type *scalar = getScalarAtOffset(type, offset, dataLayout);
+    
+    if (argClass == SSE) {
+        if (scalar && (scalar->isDoubleTy() || scalar->isVectorTy())) return scalar;
+        
+        // a float alone is passed in the low half of the register, while two floats share it.
+        if (size > 4 && getScalarAtOffset(type, offset + 4, dataLayout)) return llvm::VectorType::get(llvm::Type::getFloatTy(context), 2);
+        return llvm::Type::getFloatTy(context);
+    }
+    
+    // pointers keep their type, so that they need no conversion in the callee.
+    if (scalar && scalar->isPointerTy()) return scalar;
+    
+    return llvm::IntegerType::get(context, size * 8);
+}
+
+target::ABIArgInfo target::X8664SysVABI::classify(llvm::Type *type, bool isReturn, unsigned &freeIntRegs, unsigned &freeSSERegs, const llvm::DataLayout &dataLayout) const {
+    if (type->isVoidTy()) return ABIArgInfo();
+    
+    // scalars and vectors are lowered by LLVM, but they take the registers the aggregates after them could use.
+    if (!type->isAggregateType()) {
+        if (!isReturn) {
+            if (type->isFloatingPointTy() || type->isVectorTy()) freeSSERegs -= std::min(freeSSERegs, 1u);
+            else freeIntRegs -= std::min(freeIntRegs, 1u);
+        }
+        return ABIArgInfo();
+    }
+    
+    uint64_t size = dataLayout.getTypeAllocSize(type);
+    if (!size) return ABIArgInfo();
+    
+    ArgClass classes[2] = { NoClass, NoClass };
+    if (size > 16) classes[0] = Memory;
+    else classifyEightbytes(type, 0, classes, dataLayout);
+    
+    if (classes[0] == Memory || classes[1] == Memory) {
+        // the address of the memory receiving a return value is passed in the first integer register.
+        if (isReturn) freeIntRegs -= std::min(freeIntRegs, 1u);
+        return ABIArgInfo(ABIArgInfo::Indirect);
+    }
+    
+    // an aggregate is passed in memory, and not split, when it does not fit in the free registers.
+    if (!isReturn) {
+        unsigned neededIntRegs = std::count(classes, classes + 2, Integer);
+        unsigned neededSSERegs = std::count(classes, classes + 2, SSE);
+        if (neededIntRegs > freeIntRegs || neededSSERegs > freeSSERegs) return ABIArgInfo(ABIArgInfo::Indirect);
+        
+        freeIntRegs -= neededIntRegs;
+        freeSSERegs -= neededSSERegs;
+    }
+    
+    llvm::Type *coercedType;
+    if (classes[1] == SSEUp) {
+        coercedType = llvm::VectorType::get(llvm::Type::getDoubleTy(type->getContext()), 2);
+    } else {
+        coercedType = getEightbyteType(type, 0, classes[0], dataLayout);
+        if (classes[1] != NoClass) coercedType = llvm::StructType::get(coercedType, getEightbyteType(type, 8, classes[1], dataLayout));
+    }
+    
+    // the aggregates already made of the types of their registers need no coercion.
+    if (coercedType == type) return ABIArgInfo();
+    return ABIArgInfo(ABIArgInfo::Coerced, coercedType);
+}
+
+target::FunctionABIInfo target::X8664SysVABI::classifyFunction(llvm::Type *returnType, const std::vector<llvm::Type *> &paramTypes, const llvm::DataLayout &dataLayout) const {
+    unsigned freeIntRegs = 6, freeSSERegs = 8;
+    
+    FunctionABIInfo info;
+    info.returnInfo = classify(returnType, true, freeIntRegs, freeSSERegs, dataLayout);
+    for (llvm::Type *paramType : paramTypes) {
+        info.argInfos.push_back(classify(paramType, false, freeIntRegs, freeSSERegs, dataLayout));
+    }
+    
+    return info;
+}
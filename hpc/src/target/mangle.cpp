@@ -57,7 +57,8 @@ std::string target::NeuronMangle::mangleGlobalVariable(ast::GlobalVar *variable)
 
 std::string target::NeuronMangle::mangleType(ast::Type *type) {
     if (!type->isCanonicalType()) {
-        return mangleType(type->getCanonicalType());
+        // exclusive pointers have the same type as the others, but are passed with a different promise.
+        return (type->isExclusive() ? "X" : "") + mangleType(type->getCanonicalType());
     }
     
     if (ast::BuiltinType *builtinType = llvm::dyn_cast<ast::BuiltinType>(type)) {
@@ -89,6 +90,18 @@ std::string target::NeuronMangle::mangleType(ast::Type *type) {
         return "P" + mangleType(pointerType->getPointedType());
     }
     
+    if (ast::VectorType *vectorType = llvm::dyn_cast<ast::VectorType>(type)) {
+        return "V" + std::to_string(vectorType->getNumLanes()) + mangleType(vectorType->getElementType());
+    }
+    
+    if (ast::ArrayType *arrayType = llvm::dyn_cast<ast::ArrayType>(type)) {
+        return (arrayType->isStoredByColumns() ? "AC" : "A") + std::to_string(arrayType->getLength()) + mangleType(arrayType->getElementType());
+    }
+    
+    if (ast::SliceType *sliceType = llvm::dyn_cast<ast::SliceType>(type)) {
+        return "S" + mangleType(sliceType->getElementType());
+    }
+    
     //if (type->isConstant()) mng += "K";
     
     return "";// FIXME
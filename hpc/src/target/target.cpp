@@ -9,6 +9,8 @@
 
 #include <hpc/target/target.h>
 #include <hpc/utils/opts.h>
+#include <hpc/ast/decls/class.h>
+#include <hpc/ast/types/compoundtype.h>
 
 #include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/StringMap.h>
@@ -21,6 +23,8 @@
 #include <llvm/Target/TargetOptions.h>
 #include <llvm/Target/TargetSubtargetInfo.h>
 
+#include <algorithm>
+
 using namespace hpc;
 
 #define DisableFPElim false                             // FIXME: -disable-fp-elim flag
@@ -106,6 +110,7 @@ void target::TargetInfo::addTargetAttribs(modules::ModuleWrapper &wrapper) {
 }
 
 bool target::TargetInfo::createTargetMachine(opts::BackendOptions &backendOptions, diag::DiagEngine &diags) {
+    if (targetMachine) return true;
     
     std::string featureString = llvm::join(targetOptions.features.begin(), targetOptions.features.end(), ",");
     
@@ -143,6 +148,35 @@ llvm::DataLayout &target::TargetInfo::getDataLayout() {
     return *datalayout;
 }
 
+unsigned target::TargetInfo::getCacheLineSize() const {
+    switch (llvm::Triple(triple).getArch()) {
+        case llvm::Triple::ppc64:
+        case llvm::Triple::ppc64le:
+            return 128;
+        case llvm::Triple::systemz:
+            return 256;
+        default:
+            return 64;
+    }
+}
+
+unsigned target::TargetInfo::getClassAlignment(ast::ClassDecl *classDecl) {
+    unsigned alignment = classDecl->getRequestedAlignment();
+    if (classDecl->isCacheLineAligned()) alignment = std::max(alignment, getCacheLineSize());
+    
+    if (classDecl->isPacked()) return alignment;
+    
+    for (ast::FieldDecl *field : classDecl->getFields()) {
+        alignment = std::max(alignment, getRequestedAlignment(field->getType()));
+    }
+    return alignment;
+}
+
+unsigned target::TargetInfo::getRequestedAlignment(ast::Type *type) {
+    ast::ClassType *classType = llvm::dyn_cast<ast::ClassType>(type->getCanonicalType());
+    return classType ? getClassAlignment(classType->getDeclarator()) : 0;
+}
+
 target::TargetInfo *target::TargetInfo::fromOptions(opts::TargetOptions &targetOpts, diag::DiagEngine &diags) {
     return new target::TargetInfo(targetOpts);
 }